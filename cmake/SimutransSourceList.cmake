@@ -99,6 +99,7 @@ target_sources(simutrans PRIVATE
 		src/simutrans/gui/components/gui_schedule.cc
 		src/simutrans/gui/components/gui_scrollbar.cc
 		src/simutrans/gui/components/gui_scrolled_list.cc
+		src/simutrans/gui/components/gui_scrolled_virtual_list.cc
 		src/simutrans/gui/components/gui_scrollpane.cc
 		src/simutrans/gui/components/gui_speedbar.cc
 		src/simutrans/gui/components/gui_tab_panel.cc
@@ -281,6 +282,7 @@ target_sources(simutrans PRIVATE
 		src/simutrans/script/script_loader.cc
 		src/simutrans/script/script_tool_manager.cc
 		src/simutrans/simachievements.cc
+		src/simutrans/simbenchmark.cc
 		src/simutrans/simconvoi.cc
 		src/simutrans/simdebug.cc
 		src/simutrans/simevent.cc
@@ -308,6 +310,7 @@ target_sources(simutrans PRIVATE
 		src/simutrans/utils/checklist.cc
 		src/simutrans/utils/csv.cc
 		src/simutrans/utils/log.cc
+		src/simutrans/utils/profiler.cc
 		src/simutrans/utils/searchfolder.cc
 		src/simutrans/utils/sha1.cc
 		src/simutrans/utils/sha1_hash.cc
@@ -34,7 +34,7 @@ int main(int argc, char* argv[])
 	init_logging("stderr", true, true, "", "makeobj");
 	debuglevel = log_t::LEVEL_WARN; // only warnings and errors
 
-	while(  argc  &&  (  !STRICMP(argv[0], "quiet")  ||  !STRICMP(argv[0], "verbose")  ||  !STRICMP(argv[0], "debug")  )  ) {
+	while(  argc  &&  (  !STRICMP(argv[0], "quiet")  ||  !STRICMP(argv[0], "verbose")  ||  !STRICMP(argv[0], "debug")  ||  !STRICMP(argv[0], "incremental")  )  ) {
 
 		if (argc && !STRICMP(argv[0], "debug")) {
 			argv++; argc--;
@@ -48,6 +48,10 @@ int main(int argc, char* argv[])
 			argv++; argc--;
 			debuglevel = log_t::LEVEL_ERROR; // only fatal errors
 		}
+		else if (argc && !STRICMP(argv[0], "incremental")) {
+			argv++; argc--;
+			root_writer_t::set_incremental(true);
+		}
 	}
 
 	if(  debuglevel>=log_t::LEVEL_WARN  ) {
@@ -168,7 +172,7 @@ int main(int argc, char* argv[])
 	}
 
 	puts(
-		"\n   Usage: MakeObj [QUIET|VERBOSE|DEBUG] <Command> <params>\n"
+		"\n   Usage: MakeObj [QUIET|VERBOSE|DEBUG] [INCREMENTAL] <Command> <params>\n"
 		"\n"
 		"      MakeObj CAPABILITIES\n"
 		"         Gives the list of objects, this program can read\n"
@@ -193,6 +197,9 @@ int main(int argc, char* argv[])
 		"\n"
 		"      with QUIET as first arg status and copyright messages are omitted\n"
 		"\n"
+		"      with INCREMENTAL, PAK writing individual files keeps the files\n"
+		"      of objects whose dat file and images did not change\n"
+		"\n"
 		"      with VERBOSE as first arg also unused lines\n"
 		"      and unassigned entries are printed\n"
 		"\n"
@@ -193,7 +193,7 @@ void vehicle_builder_t::rdwr_speedbonus(loadsave_t *file)
 }
 
 
-vehicle_t* vehicle_builder_t::build(koord3d k, player_t* player, convoi_t* cnv, const vehicle_desc_t* vb )
+vehicle_t* vehicle_builder_t::build(koord3d k, player_t* player, convoi_t* cnv, const vehicle_desc_t* vb, bool book_cost )
 {
 	vehicle_t* v;
 	switch (vb->get_waytype()) {
@@ -210,7 +210,9 @@ vehicle_t* vehicle_builder_t::build(koord3d k, player_t* player, convoi_t* cnv,
 			dbg->fatal("vehicle_builder_t::build()", "cannot built a vehicle with waytype %i", vb->get_waytype());
 	}
 
-	player->book_new_vehicle(-vb->get_price(), k.get_2d(), vb->get_waytype() );
+	if(  book_cost  ) {
+		player->book_new_vehicle(-vb->get_price(), k.get_2d(), vb->get_waytype() );
+	}
 
 	return v;
 }
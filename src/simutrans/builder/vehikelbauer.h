@@ -55,7 +55,8 @@ public:
 	static bool register_desc(const vehicle_desc_t *desc);
 	static bool successfully_loaded();
 
-	static vehicle_t* build(koord3d k, player_t* player, convoi_t* cnv, const vehicle_desc_t* vb );
+	/// @param book_cost false for temporary vehicles (i.e. for route searches), which are not bought
+	static vehicle_t* build(koord3d k, player_t* player, convoi_t* cnv, const vehicle_desc_t* vb, bool book_cost = true );
 
 	static const vehicle_desc_t * get_info(const char *name);
 	static slist_tpl<vehicle_desc_t const*> const& get_info(waytype_t, uint8 sortkey = vehicle_builder_t::sb_name);
@@ -1271,6 +1271,9 @@ way_builder_t::way_builder_t(player_t* player)
 	: next_gr(32)
 	, player_builder(player)
 	, bautyp(strasse) // kann mit init_builder() gesetzt werden
+	, desc(NULL)
+	, bridge_desc(NULL)
+	, tunnel_desc(NULL)
 	, keep_existing_ways(false)
 	, keep_existing_faster_ways(false)
 	, keep_existing_city_roads(false)
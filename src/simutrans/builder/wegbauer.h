@@ -185,6 +185,9 @@ public:
 
 	uint32 get_count() const { return route.get_count(); }
 
+	/// way to build, NULL before init_builder() was called
+	const way_desc_t *get_desc() const { return desc; }
+
 	void set_prefer_parallel(bool yesno) {
 		prefer_parallel = yesno;
 	}
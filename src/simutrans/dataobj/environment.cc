@@ -136,6 +136,7 @@ bool env_t::hide_with_transparency;
 bool env_t::hide_trees;
 uint8 env_t::hide_buildings;
 bool env_t::hide_under_cursor;
+thread_local bool env_t::hiding_under_cursor = false;
 uint16 env_t::cursor_hide_range;
 bool env_t::show_single_ways;
 bool env_t::use_transparency_station_coverage;
@@ -168,6 +169,7 @@ uint32 env_t::fps;
 uint32 env_t::ff_fps;
 sint16 env_t::max_acceleration;
 uint8 env_t::num_threads;
+uint16 env_t::zoom_cache_size;
 bool env_t::show_tooltips;
 rgb888_t env_t::tooltip_color_rgb;
 PIXVAL env_t::tooltip_color;
@@ -304,6 +306,7 @@ void env_t::init()
 #else
 	num_threads = 1;
 #endif
+	zoom_cache_size = 128;
 
 	sound_distance_scaling = 10;
 
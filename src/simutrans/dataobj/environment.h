@@ -342,6 +342,18 @@ public:
 	/// buildings and trees near mouse cursor will be hidden.
 	static bool hide_under_cursor;
 
+	/**
+	 * True while the calling drawing thread draws the tiles under the mouse cursor.
+	 * Per thread, so other threads can keep drawing with the normal settings.
+	 */
+	static thread_local bool hiding_under_cursor;
+
+	/// hide_trees, including the trees under the mouse cursor
+	static bool get_hide_trees() { return hide_trees  ||  hiding_under_cursor; }
+
+	/// hide_buildings, including the buildings under the mouse cursor
+	static uint8 get_hide_buildings() { return hiding_under_cursor ? (uint8)ALL_HIDDEN_BUILDING : hide_buildings; }
+
 	/// Hide buildings and trees within range of mouse cursor
 	static uint16 cursor_hide_range;
 
@@ -443,6 +455,9 @@ public:
 	/// number of threads to use (if MULTI_THREAD defined)
 	static uint8 num_threads;
 
+	/// memory for zoomed images of the neighbour zoom levels in MB, 0 turns the prezoom cache off
+	static uint16 zoom_cache_size;
+
 	/// false to quit the programs
 	static bool quit_simutrans;
 
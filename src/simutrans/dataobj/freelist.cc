@@ -30,6 +30,12 @@ static freelist_size_t* all_lists[NUM_LIST] = {
 	NULL
 };
 
+static bool bulk_mode = false;
+static bool bulk_allowed = true;
+
+static uint64 chunk_count = 0;
+static uint64 chunk_bytes = 0;
+
 #ifdef MULTI_THREAD
 static pthread_mutex_t freelist_mutex_create = PTHREAD_MUTEX_INITIALIZER;;
 #endif
@@ -37,7 +43,7 @@ static pthread_mutex_t freelist_mutex_create = PTHREAD_MUTEX_INITIALIZER;;
 void* freelist_t::gimme_node(size_t size)
 {
 	size_t idx = (size + 3) / 4;
-	if (idx > NUM_LIST) {
+	if (idx >= NUM_LIST) {
 		return xmalloc(size);
 	}
 	if (all_lists[idx] == NULL) {
@@ -55,7 +61,7 @@ void* freelist_t::gimme_node(size_t size)
 void freelist_t::putback_node(size_t size, void* p)
 {
 	size = (size + 3) / 4;
-	if (size > NUM_LIST) {
+	if (size >= NUM_LIST) {
 		free(p);
 	}
 	else {
@@ -63,6 +69,51 @@ void freelist_t::putback_node(size_t size, void* p)
 	}
 }
 
+void freelist_t::set_bulk_mode(bool on)
+{
+	bulk_mode = on  &&  bulk_allowed;
+}
+
+
+bool freelist_t::is_bulk_mode()
+{
+	return bulk_mode;
+}
+
+
+bool freelist_t::is_bulk_mode_allowed()
+{
+	return bulk_allowed;
+}
+
+
+void freelist_t::allow_bulk_mode(bool allow)
+{
+	bulk_allowed = allow;
+	bulk_mode &= allow;
+}
+
+
+void freelist_t::add_chunk(size_t bytes)
+{
+#ifdef MULTI_THREAD
+	pthread_mutex_lock(&freelist_mutex_create);
+#endif
+	chunk_count++;
+	chunk_bytes += bytes;
+#ifdef MULTI_THREAD
+	pthread_mutex_unlock(&freelist_mutex_create);
+#endif
+}
+
+
+void freelist_t::get_chunk_stats(uint64 &count, uint64 &bytes)
+{
+	count = chunk_count;
+	bytes = chunk_bytes;
+}
+
+
 void free_all_nodes()
 {
 	for (int size = 0; size < NUM_LIST; size++) {
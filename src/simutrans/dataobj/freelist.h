@@ -6,6 +6,8 @@
 #ifndef DATAOBJ_FREELIST_H
 #define DATAOBJ_FREELIST_H
 
+#include "../simtypes.h"
+
 /**
  * Helper class to organize small memory objects i.e. nodes for linked lists
  * and such.
@@ -16,6 +18,24 @@ public:
 	static void *gimme_node( size_t size );
 	static void putback_node( size_t size, void *p );
 	static void free_all_nodes();
+
+	/**
+	 * While on, new chunks are much larger, so creating millions of nodes in a row
+	 * (i.e. while loading a game) needs only few allocations. Nodes are still freed
+	 * one by one as before.
+	 */
+	static void set_bulk_mode(bool on);
+	static bool is_bulk_mode();
+	static bool is_bulk_mode_allowed();
+
+	/// command line -no_bulk_alloc, to compare loading with and without bulk mode
+	static void allow_bulk_mode(bool allow);
+
+	/// counts a new chunk of @p bytes for the statistics
+	static void add_chunk(size_t bytes);
+
+	/// number and size of all chunks allocated so far
+	static void get_chunk_stats(uint64 &count, uint64 &bytes);
 };
 
 #endif
@@ -19,36 +19,103 @@ const uint64 powernet_t::max_capacity = (uint64)4000000 << POWER_TO_MW; // (4 TW
 const uint8 powernet_t::FRACTION_PRECISION = 16;
 
 
-slist_tpl<powernet_t *> powernet_t::powernet_list;
+vector_tpl<powernet_t *> powernet_t::powernet_list;
 
 
 void powernet_t::new_world()
 {
 	while(!powernet_list.empty()) {
-		powernet_t *net = powernet_list.remove_first();
-		delete net;
+		delete powernet_list.back();
 	}
 }
 
 
 void powernet_t::step_all(uint32 delta_t)
 {
-	for(powernet_t* const p : powernet_list) {
-		p->step(delta_t);
+	// backwards, since unused nets are removed
+	for(  uint32 i = powernet_list.get_count();  i-- > 0;  ) {
+		powernet_t *p = powernet_list[i];
+		if(  p->users == 0  ) {
+			if(  p->parent  ) {
+				p->parent->remove_user();
+			}
+			delete p;
+		}
+		else if(  p->parent  ) {
+			// path compression: merged nets point directly to their representative
+			powernet_t *root = p->get_representative();
+			if(  p->parent != root  ) {
+				root->add_user();
+				p->parent->remove_user();
+				p->parent = root;
+			}
+		}
+		else {
+			p->step(delta_t);
+		}
 	}
 }
 
 
+powernet_t *powernet_t::get_representative() const
+{
+	const powernet_t *p = this;
+	while(  p->parent  ) {
+		p = p->parent;
+	}
+	return const_cast<powernet_t *>(p);
+}
+
+
+powernet_t *powernet_t::merge(powernet_t *keep, powernet_t *other)
+{
+	powernet_t *root = keep->get_representative();
+	powernet_t *child = other->get_representative();
+	if(  root == child  ) {
+		return root;
+	}
+	// the state must not depend on which net becomes the representative
+	const sint32 demand = root->norm_demand;
+	const sint32 supply = root->norm_supply;
+
+	// union by rank
+	if(  root->rank < child->rank  ) {
+		powernet_t *tmp = root;
+		root = child;
+		child = tmp;
+	}
+	else if(  root->rank == child->rank  ) {
+		root->rank++;
+	}
+	child->parent = root;
+	root->add_user();
+
+	root->power_supply += child->power_supply;
+	root->power_demand += child->power_demand;
+	child->power_supply = 0;
+	child->power_demand = 0;
+
+	root->norm_demand = demand;
+	root->norm_supply = supply;
+	return root;
+}
+
+
 powernet_t::powernet_t()
 {
 #ifdef MULTI_THREAD
 	pthread_mutex_lock( &netlist_mutex );
 #endif
-	powernet_list.insert( this );
+	list_index = powernet_list.get_count();
+	powernet_list.append( this );
 #ifdef MULTI_THREAD
 	pthread_mutex_unlock( &netlist_mutex );
 #endif
 
+	parent = NULL;
+	rank = 0;
+	users = 0;
+
 	power_supply = 0;
 	power_demand = 0;
 
@@ -62,7 +129,11 @@ powernet_t::~powernet_t()
 #ifdef MULTI_THREAD
 	pthread_mutex_lock( &netlist_mutex );
 #endif
-	powernet_list.remove( this );
+	// move the last net to our place
+	powernet_t *last = powernet_list.back();
+	powernet_list[list_index] = last;
+	last->list_index = list_index;
+	powernet_list.pop_back();
 #ifdef MULTI_THREAD
 	pthread_mutex_unlock( &netlist_mutex );
 #endif
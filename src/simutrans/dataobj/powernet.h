@@ -8,7 +8,7 @@
 
 
 #include "../simtypes.h"
-#include "../tpl/slist_tpl.h"
+#include "../tpl/vector_tpl.h"
 
 
 /** @file powernet.h Data structure to manage a net of powerlines - a powernet */
@@ -17,6 +17,8 @@
 /**
  * Data class for power networks. A two phase queue to store
  * and hand out power.
+ * Connected nets are merged like a disjoint set: the merged net points to
+ * the representative, which holds supply and demand of both.
  */
 class powernet_t
 {
@@ -39,7 +41,20 @@ public:
 	static void step_all(uint32 delta_t);
 
 private:
-	static slist_tpl<powernet_t *> powernet_list;
+	/// all nets, also those merged into others
+	static vector_tpl<powernet_t *> powernet_list;
+
+	/// position in powernet_list
+	uint32 list_index;
+
+	/// net this net was merged into, NULL for a representative
+	powernet_t *parent;
+
+	/// upper bound of the height of the tree below, keeps the way to the representative short
+	uint8 rank;
+
+	/// number of power lines and merged nets pointing here
+	uint32 users;
 
 	// Network power supply.
 	uint64 power_supply;
@@ -60,6 +75,24 @@ public:
 
 	uint64 get_max_capacity() const { return max_capacity; }
 
+	/**
+	 * The net which holds supply and demand for all nets merged with this one.
+	 */
+	powernet_t *get_representative() const;
+
+	/**
+	 * Joins the nets of @p keep and @p other.
+	 * The joined net shows the supply and demand state of @p keep until the next step.
+	 * @return the representative of the joined net
+	 */
+	static powernet_t *merge(powernet_t *keep, powernet_t *other);
+
+	/// a power line or merged net uses this net
+	void add_user() { users++; }
+
+	/// unused nets are deleted in the next step
+	void remove_user() { users--; }
+
 	/**
 	 * Add power supply for next step.
 	 */
@@ -38,9 +38,13 @@
 #endif
 
 
+uint32 route_t::last_version = 0;
+
+
 void route_t::append(const route_t *r)
 {
 	assert(r != NULL);
+	changed();
 	const uint32 hops = r->get_count()-1;
 	route.reserve(hops+1+route.get_count());
 
@@ -58,10 +62,12 @@ void route_t::append(const route_t *r)
 void route_t::insert(koord3d k)
 {
 	route.insert_at(0,k);
+	changed();
 }
 
 
 void route_t::remove_koord_from(uint32 i) {
+	changed();
 	while(  i+1 < get_count()  ) {
 		route.pop_back();
 	}
@@ -83,6 +89,7 @@ bool route_t::append_straight_route(karte_t *welt, koord3d dest )
 
 	// then try to calculate direct route
 	koord pos = back().get_2d();
+	changed();
 	route.reserve( route.get_count()+koord_distance(pos,ziel)+2 );
 	DBG_MESSAGE("route_t::append_straight_route()","start from (%i,%i) to (%i,%i)",pos.x,pos.y,dest.x,dest.y);
 	while(pos!=ziel) {
@@ -140,6 +147,7 @@ bool route_t::find_route(karte_t *welt, const koord3d start, test_driver_t *tdri
 
 	// we clear it here probably twice: does not hurt ...
 	route.clear();
+	changed();
 
 	// first tile is not valid?!?
 	if(  !tdriver->check_next_tile(g)  ) {
@@ -302,6 +310,7 @@ bool route_t::intern_calc_route(karte_t *welt, const koord3d ziel, const koord3d
 
 	// we clear it here probably twice: does not hurt ...
 	route.clear();
+	changed();
 
 	// first tile is not valid?!?
 	if(  !tdriver->check_next_tile(gr)  ) {
@@ -683,6 +692,7 @@ void route_t::postprocess_water_route(karte_t *welt)
 route_t::route_result_t route_t::calc_route(karte_t *welt, const koord3d ziel, const koord3d start, test_driver_t *tdriver, const sint32 max_khm, sint32 max_len )
 {
 	route.clear();
+	changed();
 
 	INT_CHECK("route 336");
 
@@ -763,6 +773,7 @@ void route_t::rdwr(loadsave_t *file)
 	if(file->is_loading()) {
 		koord3d k;
 		route.clear();
+		changed();
 		route.reserve(max_n+2);
 		for(sint32 i=0;  i<=max_n;  i++ ) {
 			k.rdwr(file);
@@ -37,6 +37,12 @@ private:
 
 	koord3d_vector_t route;           // The coordinates for the vehicle route
 
+	/// changes with every modification, unique for all routes
+	uint32 version;
+	static uint32 last_version;
+
+	void changed() { version = ++last_version; }
+
 	void postprocess_water_route(karte_t *welt);
 
 	static inline uint32 calc_distance( const koord3d &p1, const koord3d &target )
@@ -81,9 +87,17 @@ public:
 	static void RELEASE_NODE() {}
 #endif
 
+	route_t() : version(0) {}
+
 	const koord3d_vector_t &get_route() const { return route; }
 
-	void rotate90( sint16 y_size ) { route.rotate90( y_size ); }
+	/**
+	 * Two routes with the same version have the same tiles, so results
+	 * depending only on the tiles of a route can be kept until it is changed.
+	 */
+	uint32 get_version() const { return version; }
+
+	void rotate90( sint16 y_size ) { route.rotate90( y_size ); changed(); }
 
 
 	bool is_contained(const koord3d &k) const { return route.is_contained(k); }
@@ -116,12 +130,12 @@ public:
 	/**
 	 * Appends position @p k.
 	 */
-	inline void append(koord3d k) { route.append(k); }
+	inline void append(koord3d k) { route.append(k); changed(); }
 
 	/**
 	 * removes all tiles from the route
 	 */
-	void clear() { route.clear(); }
+	void clear() { route.clear(); changed(); }
 
 	/**
 	 * Removes all tiles at indices >@p i.
@@ -316,6 +316,16 @@ void tabfileobj_t::unused( const char *exclude_start_chars )
 	}
 }
 
+vector_tpl<const char *> tabfileobj_t::get_values() const
+{
+	vector_tpl<const char *> values( objinfo.get_count() );
+	for(auto const& i : objinfo) {
+		values.append( i.value.str );
+	}
+	return values;
+}
+
+
 static bool match_ribi(const char *p)
 {
 	return
@@ -191,6 +191,12 @@ public:
 	 */
 	vector_tpl<int> get_ints(const char *key);
 	vector_tpl<sint64> get_sint64s(const char *key);
+
+	/**
+	 * Get all values, e.g. to find the files an object refers to.
+	 * The values are not marked as used.
+	 */
+	vector_tpl<const char *> get_values() const;
 };
 
 #endif
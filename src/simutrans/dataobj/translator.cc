@@ -39,6 +39,71 @@ static char *fgets_line(char *buffer, int max_len, FILE *file)
 }
 
 
+uint32 translator::text_table_t::hash(const char *key)
+{
+	// FNV-1a over the whole text, since many texts start the same
+	uint32 h = 2166136261u;
+	while(  *key  ) {
+		h = (h ^ (uint8)*key++) * 16777619u;
+	}
+	return h;
+}
+
+
+uint32 translator::text_table_t::find(const char *key, uint32 h) const
+{
+	const uint32 mask = entries.get_count() - 1;
+	uint32 i = h & mask;
+	while(  entries[i].key  &&  (entries[i].hash != h  ||  strcmp(entries[i].key, key) != 0)  ) {
+		i = (i + 1) & mask;
+	}
+	return i;
+}
+
+
+void translator::text_table_t::enlarge()
+{
+	const uint32 new_size = entries.empty() ? 1024 : entries.get_count() * 2;
+	vector_tpl<entry_t> old_entries( new_size );
+	swap( old_entries, entries );
+
+	entry_t empty = { NULL, NULL, 0 };
+	for(  uint32 i = 0;  i < new_size;  i++  ) {
+		entries.append( empty );
+	}
+	for(entry_t const& e : old_entries) {
+		if(  e.key  ) {
+			entries[ find( e.key, e.hash ) ] = e;
+		}
+	}
+}
+
+
+const char *translator::text_table_t::get(const char *key) const
+{
+	if(  count == 0  ) {
+		return NULL;
+	}
+	return entries[ find( key, hash( key ) ) ].value;
+}
+
+
+void translator::text_table_t::set(const char *key, const char *value)
+{
+	if(  2 * (count + 1) > entries.get_count()  ) {
+		enlarge();
+	}
+	const uint32 h = hash( key );
+	entry_t &e = entries[ find( key, h ) ];
+	if(  e.key == NULL  ) {
+		e.key = key;
+		e.hash = h;
+		count++;
+	}
+	e.value = value;
+}
+
+
 const char *translator::lang_info::translate(const char *text) const
 {
 	if(  text    == NULL  ) {
@@ -55,7 +120,7 @@ const char *translator::lang_info::translate(const char *text) const
 /* Made to be dynamic, allowing any number of languages to be loaded */
 static translator::lang_info langs[40];
 static translator::lang_info *current_langinfo = langs;
-static stringhashtable_tpl<const char*> compatibility;
+static translator::text_table_t compatibility;
 
 
 translator translator::single_instance;
@@ -315,7 +380,7 @@ static bool is_special_format_string(const char* str)
 }
 
 
-static void load_language_file_body(FILE* file, stringhashtable_tpl<const char*>* table, bool language_is_utf, bool file_is_utf, bool language_is_latin2 )
+static void load_language_file_body(FILE* file, translator::text_table_t* table, bool language_is_utf, bool file_is_utf, bool language_is_latin2 )
 {
 	char buffer1 [4096];
 	char buffer2 [4096];
@@ -47,10 +47,43 @@ private:
 	static void load_custom_list( int lang, vector_tpl<char*> &name_list, const char *fileprefix );
 
 public:
+	/**
+	 * Texts and their translations.
+	 * Open addressing with a hash of the whole text, so a lookup
+	 * usually compares only one string.
+	 */
+	class text_table_t {
+		struct entry_t {
+			const char *key;
+			const char *value;
+			uint32 hash;
+		};
+
+		/// size is a power of two, at most half of the entries are used
+		vector_tpl<entry_t> entries;
+		uint32 count;
+
+		static uint32 hash(const char *key);
+
+		/// @returns index of the entry for @p key, or of the empty entry to use for it
+		uint32 find(const char *key, uint32 h) const;
+
+		void enlarge();
+
+	public:
+		text_table_t() : count(0) {}
+
+		/// @returns translation of @p key or NULL
+		const char *get(const char *key) const;
+
+		/// adds or replaces a translation, @p key is kept if it is new
+		void set(const char *key, const char *value);
+	};
+
 	struct lang_info {
 		const char* translate(const char* text) const;
 
-		stringhashtable_tpl<const char*> texts;
+		text_table_t texts;
 		const char *name;
 		const char *iso;
 		const char *iso_base;
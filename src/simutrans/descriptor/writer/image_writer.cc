@@ -7,6 +7,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <string>
+#include <sys/stat.h>
 #include "image_writer.h"
 #include "root_writer.h"
 #include "obj_node.h"
@@ -32,17 +33,20 @@ struct dimension
 };
 
 
-std::string image_writer_t::last_img_file;
+/// image files are kept in memory up to this size in bytes
+#define MAX_IMAGE_CACHE_SIZE (512*1024*1024)
 
-raw_image_t image_writer_t::input_img;
+vector_tpl<image_writer_t::cached_image_t> image_writer_t::image_cache;
+
+const raw_image_t *image_writer_t::input_img = NULL;
 int image_writer_t::img_size = 64;
 
 
 uint32 image_writer_t::block_getpix(int x, int y)
 {
-	const uint8 *pixel_data = input_img.access_pixel(x, y);
+	const uint8 *pixel_data = input_img->access_pixel(x, y);
 
-	switch (input_img.get_format()) {
+	switch (input_img->get_format()) {
 		case raw_image_t::FMT_GRAY8: {
 			const uint8 gray_level = pixel_data[0];
 			return
@@ -259,34 +263,64 @@ uint16 *image_writer_t::encode_image(int x, int y, dimension* dim, int* len)
 
 bool image_writer_t::block_load(const char *fname)
 {
-	// The last image file is cached
+	// Recently used image files are cached, since the images of an object
+	// or of several objects are often spread over a few sheets.
 	// Note that this method accepts any file name if the content has a supported format,
 	// even though makeobj only supports image file names with a ".png" suffix.
 	// See image_writer_t::write_obj for details.
-	if(  last_img_file == fname  ) {
-		return true;
-	}
-	else if (load_image_from_file(fname)) {
-		if ((input_img.get_width()%img_size != 0) || (input_img.get_height()%img_size != 0)) {
-			dbg->error("image_writer_t::block_load", "Cannot load image file '%s': "
-				"Size not divisible by %d.", fname, img_size);
-			last_img_file = "";
-			return false;
+	for(  uint32 i = 0;  i < image_cache.get_count();  i++  ) {
+		if(  image_cache[i].fname == fname  ) {
+			if(  i > 0  ) {
+				cached_image_t entry = image_cache[i];
+				image_cache.remove_at(i);
+				image_cache.insert_at(0, entry);
+			}
+			input_img = image_cache[0].img;
+			return true;
 		}
+	}
 
-		last_img_file = fname;
-		return true;
+	raw_image_t *img = new raw_image_t();
+	if (!load_image_from_file(fname, *img)) {
+		// error message is handled by image_writer_t::write_obj
+		delete img;
+		return false;
+	}
+	if ((img->get_width()%img_size != 0) || (img->get_height()%img_size != 0)) {
+		dbg->error("image_writer_t::block_load", "Cannot load image file '%s': "
+			"Size not divisible by %d.", fname, img_size);
+		delete img;
+		return false;
 	}
 
-	// error message is handled by image_writer_t::write_obj
-	last_img_file = "";
-	return false;
+	cached_image_t entry;
+	entry.fname = fname;
+	entry.img = img;
+	image_cache.insert_at(0, entry);
+	input_img = img;
+
+	// forget the least recently used files
+	uint64 cache_size = 0;
+	for(  uint32 i = 0;  i < image_cache.get_count();  i++  ) {
+		const raw_image_t *cached = image_cache[i].img;
+		cache_size += (uint64)cached->get_width() * cached->get_height() * (cached->get_bpp() / 8);
+		if(  i > 0  &&  cache_size > MAX_IMAGE_CACHE_SIZE  ) {
+			while(  image_cache.get_count() > i  ) {
+				delete image_cache.back().img;
+				image_cache.pop_back();
+			}
+			break;
+		}
+	}
+	return true;
 }
 
 
-bool image_writer_t::load_image_from_file(const char* fname)
+bool image_writer_t::find_image_file(const char *fname, std::string &found)
 {
-	if (input_img.read_from_file(fname)) {
+	struct stat st;
+	if (stat(fname, &st) == 0) {
+		found = fname;
 		return true;
 	}
 
@@ -329,7 +363,8 @@ bool image_writer_t::load_image_from_file(const char* fname)
 		}
 
 		if (sep_beg == end) {
-			return input_img.read_from_file(actual_path.c_str());
+			found = actual_path;
+			return true;
 		}
 		sep_end = sep_beg + strspn(sep_beg, "/");
 	}
@@ -339,6 +374,38 @@ bool image_writer_t::load_image_from_file(const char* fname)
 }
 
 
+bool image_writer_t::load_image_from_file(const char* fname, raw_image_t &img)
+{
+	std::string actual_path;
+	return find_image_file(fname, actual_path)  &&  img.read_from_file(actual_path.c_str());
+}
+
+
+std::string image_writer_t::get_image_file(std::string imagekey)
+{
+	if(  !imagekey.empty()  &&  imagekey[0] == '>'  ) {
+		imagekey = imagekey.substr(1);
+	}
+	imagekey = trim(imagekey);
+
+	// the image number starts after the first dot of the file name
+	size_t start = imagekey.rfind('/');
+	size_t dot = imagekey.find('.', start == std::string::npos ? 0 : start + 1);
+	if(  dot == std::string::npos  ||  dot == 0  ) {
+		return "";
+	}
+	// not an image number, or a decimal number instead of a file name
+	size_t number = imagekey.find_first_not_of(' ', dot + 1);
+	if(  number == std::string::npos  ||  imagekey[number] < '0'  ||  imagekey[number] > '9'  ) {
+		return "";
+	}
+	if(  imagekey.find_first_not_of("0123456789+- ") >= dot  ) {
+		return "";
+	}
+	return root_writer_t::get_inpath() + imagekey.substr(0, dot) + ".png";
+}
+
+
 /* the syntax for image the string is
  *   "-" empty image
  * [> ]imagefilename_without_extension[[[[.row].col],xoffset],yoffset]
@@ -413,10 +480,10 @@ void image_writer_t::write_obj(FILE* outfp, obj_node_t& parent, std::string an_i
 		}
 
 		if (col == -1) {
-			col = row % (input_img.get_width()  / img_size);
-			row = row / (input_img.get_height() / img_size);
+			col = row % (input_img->get_width()  / img_size);
+			row = row / (input_img->get_height() / img_size);
 		}
-		if (col >= (int)(input_img.get_width() / img_size) || row >= (int)(input_img.get_height() / img_size)) {
+		if (col >= (int)(input_img->get_width() / img_size) || row >= (int)(input_img->get_height() / img_size)) {
 			char reason[1024];
 			sprintf(reason, "invalid image number in %s.%s", imagekey.c_str(), numkey.c_str());
 			throw obj_pak_exception_t("image_writer_t", reason);
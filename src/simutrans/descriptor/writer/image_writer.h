@@ -12,6 +12,7 @@
 #include "obj_writer.h"
 #include "../objversion.h"
 #include "../../io/raw_image.h"
+#include "../../tpl/vector_tpl.h"
 
 
 class obj_node_t;
@@ -23,8 +24,19 @@ class image_writer_t : public obj_writer_t
 private:
 	static image_writer_t the_instance;
 
-	static std::string last_img_file;
-	static raw_image_t input_img;
+	/// image file read from disk, kept for later images on the same sheet
+	struct cached_image_t
+	{
+		std::string fname;
+		raw_image_t *img;
+	};
+
+	/// recently used image files, the most recent first
+	static vector_tpl<cached_image_t> image_cache;
+
+	/// image file of the current image, first entry of @ref image_cache
+	static const raw_image_t *input_img;
+
 	static int img_size; // default 64
 
 	image_writer_t() { register_writer(false); }
@@ -41,12 +53,22 @@ public:
 
 	void write_obj(FILE* fp, obj_node_t& parent, std::string imagekey, uint32 index);
 
+	/**
+	 * @returns file name of the image file an image key refers to (relative to the input path)
+	 *  or an empty string, if @p imagekey is not a reference to an image
+	 */
+	static std::string get_image_file(std::string imagekey);
+
+	/// Finds @p fname like load_image_from_file() does, i.e. ignoring the case.
+	/// @returns true and the actual file name in @p found, if the file exists
+	static bool find_image_file(const char *fname, std::string &found);
+
 private:
 	bool block_load(const char* fname);
 
-	/// Loads @ref input_img with the contents of @p fname, ignores case of @p filename.
+	/// Loads @p img with the contents of @p fname, ignores case of @p filename.
 	/// @returns true on success
-	bool load_image_from_file(const char *fname);
+	bool load_image_from_file(const char *fname, raw_image_t &img);
 
 	/// Encodes an image into a sprite data structure, considers
 	/// special colors.
@@ -5,9 +5,11 @@
 
 #include <string>
 #include <stdlib.h>
+#include <sys/stat.h>
 #include "../../dataobj/tabfile.h"
 #include "../../utils/searchfolder.h"
 #include "../obj_desc.h"
+#include "image_writer.h"
 #include "obj_node.h"
 #include "obj_writer.h"
 #include "root_writer.h"
@@ -15,6 +17,72 @@
 using std::string;
 
 string root_writer_t::inpath;
+bool root_writer_t::incremental = false;
+
+
+static bool get_modification_time(const char *fname, time_t &mtime)
+{
+	struct stat st;
+	if(  stat(fname, &st) != 0  ) {
+		return false;
+	}
+	mtime = st.st_mtime;
+	return true;
+}
+
+
+/**
+ * @returns true if the pak file @p pak_name is newer than the dat file @p dat_name
+ * and all images the object refers to
+ */
+static bool is_pak_up_to_date(const string &pak_name, const char *dat_name, const tabfileobj_t &obj)
+{
+	time_t pak_time, mtime;
+	if(  !get_modification_time(pak_name.c_str(), pak_time)  ) {
+		return false;
+	}
+	if(  !get_modification_time(dat_name, mtime)  ||  mtime >= pak_time  ) {
+		return false;
+	}
+	for(const char *value : obj.get_values()) {
+		const string image_file = image_writer_t::get_image_file(value);
+		if(  image_file.empty()  ) {
+			continue;
+		}
+		// a missing image must fail like in a full build
+		string found;
+		if(  !image_writer_t::find_image_file(image_file.c_str(), found)  ||  !get_modification_time(found.c_str(), mtime)  ||  mtime >= pak_time  ) {
+			return false;
+		}
+	}
+	return true;
+}
+
+
+/// file in the output directory with the settings of the last build
+#define INCREMENTAL_STAMP ".makeobj_stamp"
+
+/// @returns the settings, which change the paks of all objects
+static string get_build_stamp()
+{
+	char buf[64];
+	sprintf(buf, "%u %i\n", (unsigned)COMPILER_VERSION_CODE, obj_writer_t::get_img_size());
+	return buf;
+}
+
+
+/// @returns true if the last build in @p dir used the same settings
+static bool is_stamp_up_to_date(const string &dir)
+{
+	FILE *fp = fopen((dir + INCREMENTAL_STAMP).c_str(), "r");
+	if(  !fp  ) {
+		return false;
+	}
+	char buf[64];
+	const bool ok = fgets(buf, sizeof(buf), fp) != NULL  &&  get_build_stamp() == buf;
+	fclose(fp);
+	return ok;
+}
 
 void root_writer_t::write_header(FILE* fp)
 {
@@ -39,9 +107,17 @@ void root_writer_t::write(const char* filename, int argc, char* argv[])
 	bool separate = false;
 	string file = find.complete(filename, "pak");
 
+	bool keep_up_to_date = false;
 	if (file[file.size()-1] == '/') {
 		printf("writing individual files to %s\n", filename);
 		separate = true;
+		if(  incremental  ) {
+			// another makeobj version or tile size changes all paks
+			keep_up_to_date = is_stamp_up_to_date(filename);
+			if(  !keep_up_to_date  ) {
+				printf("settings changed, writing all files\n");
+			}
+		}
 	}
 	else {
 		outfp = fopen(file.c_str(), "wb");
@@ -88,6 +164,13 @@ void root_writer_t::write(const char* filename, int argc, char* argv[])
 
 						name = name + obj.get("obj") + "." + obj.get("name") + ".pak";
 
+						if(  keep_up_to_date  &&  is_pak_up_to_date(name, i, obj)  ) {
+							if (debuglevel >= log_t::LEVEL_MSG) {
+								printf("   Keeping file %s\n", name.c_str());
+							}
+							continue;
+						}
+
 						outfp = fopen(name.c_str(), "wb");
 						if (!outfp) {
 							dbg->fatal( "Write pak", "Cannot create destination file %s", filename );
@@ -120,6 +203,10 @@ void root_writer_t::write(const char* filename, int argc, char* argv[])
 		delete node;
 		fclose(outfp);
 	}
+	else if(  FILE *fp = fopen((string(filename) + INCREMENTAL_STAMP).c_str(), "w")  ) {
+		fputs(get_build_stamp().c_str(), fp);
+		fclose(fp);
+	}
 }
 
 
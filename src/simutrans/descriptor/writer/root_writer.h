@@ -24,6 +24,9 @@ private:
 
 	static std::string inpath;
 
+	/// keep pak files of objects which did not change
+	static bool incremental;
+
 	root_writer_t() { register_writer(false); }
 
 	void copy_nodes(FILE* outfp, FILE* infp, obj_node_info_t& info);
@@ -61,6 +64,12 @@ public:
 
 	static const std::string & get_inpath() { return inpath; }
 
+	/**
+	 * When writing individual files, objects are skipped if their pak file
+	 * is newer than their dat file and all images they refer to.
+	 */
+	static void set_incremental(bool yesno) { incremental = yesno; }
+
 private:
 	bool do_copy(FILE* outfp, obj_node_info_t& root, const char* open_file_name);
 	bool do_dump(const char* open_file_name);
@@ -269,6 +269,34 @@ clipping_info_t clips;
 
 static font_t default_font;
 
+/*
+ * Layout cache for short strings: the glyphs after UTF-8 decoding and the width.
+ * GUI lists draw the same labels every frame, so they are decoded only once.
+ * One direct mapped cache per clipping area, i.e. per drawing thread.
+ */
+#define TEXT_LAYOUT_CACHE_BITS (9)
+#define TEXT_LAYOUT_MAX_LEN (96) // longer strings are not cached
+
+struct text_layout_t
+{
+	uint32 hash;
+	uint32 font_generation; // 0: unused
+	uint16 text_len;
+	uint16 glyph_count;
+	scr_coord_val width;
+	char text[TEXT_LAYOUT_MAX_LEN];
+	utf32 glyphs[TEXT_LAYOUT_MAX_LEN];
+};
+
+// incremented on each font change
+static uint32 text_layout_font_generation = 1;
+
+#ifdef MULTI_THREAD
+static text_layout_t *text_layouts[MAX_THREADS];
+#else
+static text_layout_t *text_layouts = NULL;
+#endif
+
 // needed for resizing gui
 int default_font_ascent = 0;
 int default_font_linespace = 0;
@@ -366,6 +394,8 @@ struct imd {
 
 	PIXVAL* zoom_data; // zoomed original data
 	uint32 len;    // current zoom image data size (or base if not zoomed) (used for allocation purposes only)
+	sint8 zoom_level;       // zoom factor of zoom_data, -1 for none
+	uint32 zoom_generation; // zoom_generation when last rezoomed, i.e. drawn
 
 	sint16 base_x; // min x offset
 	sint16 base_y; // min y offset
@@ -947,6 +977,198 @@ void display_mark_img_dirty(image_id image, scr_coord_val xp, scr_coord_val yp)
  * They are derived from a base image, which may need zooming too
  */
 
+/*
+ * Prezoom cache: zoomed data of the zoom levels next to the current one.
+ * rezoom_img() keeps the data of the old level here, and a background thread
+ * prepares the neighbour levels for images drawn recently. So zooming in and out
+ * only needs to recolour the images, not to resample them.
+ * An entry of image n is only accessed with rezoom_img_mutex[n % env_t::num_threads] locked.
+ */
+struct zoomed_img_t
+{
+	sint16 x, y, w, h;
+	uint32 len;
+	PIXVAL *data; // NULL: not cached
+};
+
+static zoomed_img_t *prezoom_cache[MAX_ZOOM_FACTOR + 1];
+static image_id prezoom_cache_count[MAX_ZOOM_FACTOR + 1];
+static size_t prezoom_memory = 0;
+
+// incremented on each zoom change, to find recently drawn images
+static uint32 zoom_generation = 1;
+
+#ifdef MULTI_THREAD
+static pthread_mutex_t prezoom_memory_mutex;
+static pthread_t prezoom_thread;
+static bool prezoom_running = false;
+static volatile bool prezoom_stop_request = false;
+static int prezoom_level; // zoom factor the thread prepares the neighbours of
+#endif
+
+static void zoom_img_data(const image_id n, const int zf, zoomed_img_t &out);
+
+
+static bool prezoom_reserve(size_t bytes)
+{
+#ifdef MULTI_THREAD
+	pthread_mutex_lock( &prezoom_memory_mutex );
+#endif
+	const bool ok = prezoom_memory + bytes <= ((size_t)env_t::zoom_cache_size << 20);
+	if(  ok  ) {
+		prezoom_memory += bytes;
+	}
+#ifdef MULTI_THREAD
+	pthread_mutex_unlock( &prezoom_memory_mutex );
+#endif
+	return ok;
+}
+
+
+static void prezoom_release(size_t bytes)
+{
+#ifdef MULTI_THREAD
+	pthread_mutex_lock( &prezoom_memory_mutex );
+#endif
+	prezoom_memory -= bytes;
+#ifdef MULTI_THREAD
+	pthread_mutex_unlock( &prezoom_memory_mutex );
+#endif
+}
+
+
+static bool prezoom_full()
+{
+#ifdef MULTI_THREAD
+	pthread_mutex_lock( &prezoom_memory_mutex );
+#endif
+	const bool full = prezoom_memory >= ((size_t)env_t::zoom_cache_size << 20);
+#ifdef MULTI_THREAD
+	pthread_mutex_unlock( &prezoom_memory_mutex );
+#endif
+	return full;
+}
+
+
+/// keeps zoomed data of image n for level zl, @return false if not taken (caller must free the data)
+static bool prezoom_store(const image_id n, const int zl, const zoomed_img_t &z)
+{
+	if(  zl < 0  ||  prezoom_cache[zl] == NULL  ||  n >= prezoom_cache_count[zl]  ||  prezoom_cache[zl][n].data != NULL  ) {
+		return false;
+	}
+	if(  !prezoom_reserve( z.len * sizeof(PIXVAL) )  ) {
+		return false;
+	}
+	prezoom_cache[zl][n] = z;
+	return true;
+}
+
+
+/// gets the cached data of image n for level zl, which are then owned by the caller
+static bool prezoom_take(const image_id n, const int zl, zoomed_img_t &z)
+{
+	if(  prezoom_cache[zl] == NULL  ||  n >= prezoom_cache_count[zl]  ||  prezoom_cache[zl][n].data == NULL  ) {
+		return false;
+	}
+	z = prezoom_cache[zl][n];
+	prezoom_cache[zl][n].data = NULL;
+	prezoom_release( z.len * sizeof(PIXVAL) );
+	return true;
+}
+
+
+static void prezoom_free_level(const int zl)
+{
+	if(  prezoom_cache[zl]  ) {
+		for(  image_id n = 0;  n < prezoom_cache_count[zl];  n++  ) {
+			if(  prezoom_cache[zl][n].data  ) {
+				prezoom_release( prezoom_cache[zl][n].len * sizeof(PIXVAL) );
+				free( prezoom_cache[zl][n].data );
+			}
+		}
+		free( prezoom_cache[zl] );
+		prezoom_cache[zl] = NULL;
+		prezoom_cache_count[zl] = 0;
+	}
+}
+
+
+#ifdef MULTI_THREAD
+// prepares the levels next to zoom_factor for all images drawn during the last two zoom levels
+static void *prezoom_thread_loop(void *)
+{
+	const int levels[2] = { prezoom_level - 1, prezoom_level + 1 };
+	bool full = false;
+	for(  image_id n = 0;  n < anz_images  &&  !prezoom_stop_request  &&  !full;  n++  ) {
+		// drawing changes the flags of the image under this lock
+		pthread_mutex_lock( &rezoom_img_mutex[n % env_t::num_threads] );
+		if(  (images[n].recode_flags & FLAG_ZOOMABLE) != 0  &&  images[n].base_h > 0  &&  images[n].zoom_generation + 1 >= zoom_generation  ) {
+			for(  int i = 0;  i < 2;  i++  ) {
+				const int zl = levels[i];
+				if(  zl < 0  ||  zl > MAX_ZOOM_FACTOR  ||  zl == ZOOM_NEUTRAL  ||  prezoom_cache[zl] == NULL  ||  n >= prezoom_cache_count[zl]  ) {
+					continue;
+				}
+				if(  prezoom_full()  ) {
+					full = true;
+					break;
+				}
+				if(  prezoom_cache[zl][n].data == NULL  &&  images[n].zoom_level != zl  ) {
+					zoomed_img_t z;
+					zoom_img_data( n, zl, z );
+					if(  z.data  &&  !prezoom_store( n, zl, z )  ) {
+						free( z.data );
+					}
+				}
+			}
+		}
+		pthread_mutex_unlock( &rezoom_img_mutex[n % env_t::num_threads] );
+	}
+	return NULL;
+}
+#endif
+
+
+// stops the background thread, must be called before changing the image table
+static void prezoom_stop()
+{
+#ifdef MULTI_THREAD
+	if(  prezoom_running  ) {
+		prezoom_stop_request = true;
+		pthread_join( prezoom_thread, NULL );
+		prezoom_running = false;
+	}
+#endif
+}
+
+
+// drops the levels far from zoom_factor and starts preparing the neighbour levels
+static void prezoom_restart()
+{
+	prezoom_stop();
+	for(  int zl = 0;  zl <= MAX_ZOOM_FACTOR;  zl++  ) {
+		if(  env_t::zoom_cache_size == 0  ||  zl == ZOOM_NEUTRAL  ||  abs( zl - (int)zoom_factor ) > 1  ) {
+			prezoom_free_level( zl );
+		}
+		else if(  prezoom_cache_count[zl] < anz_images  ) {
+			prezoom_cache[zl] = REALLOC( prezoom_cache[zl], zoomed_img_t, anz_images );
+			memset( prezoom_cache[zl] + prezoom_cache_count[zl], 0, (anz_images - prezoom_cache_count[zl]) * sizeof(zoomed_img_t) );
+			prezoom_cache_count[zl] = anz_images;
+		}
+	}
+#ifdef MULTI_THREAD
+	if(  env_t::zoom_cache_size > 0  ) {
+		prezoom_stop_request = false;
+		prezoom_level = zoom_factor;
+		pthread_attr_t attr;
+		pthread_attr_init( &attr );
+		pthread_attr_setdetachstate( &attr, PTHREAD_CREATE_JOINABLE );
+		prezoom_running = pthread_create( &prezoom_thread, &attr, prezoom_thread_loop, NULL ) == 0;
+		pthread_attr_destroy( &attr );
+	}
+#endif
+}
+
+
 /**
  * Flag all images for rezoom on next draw
  */
@@ -964,10 +1186,14 @@ void set_zoom_factor(int z)
 {
 	// do not zoom beyond 4 pixels
 	if(  (base_tile_raster_width * zoom_num[z]) / zoom_den[z] > 4  ) {
+		// the thread reads the image flags and the zoom generation
+		prezoom_stop();
 		zoom_factor = z;
 		tile_raster_width = (base_tile_raster_width * zoom_num[zoom_factor]) / zoom_den[zoom_factor];
 		dbg->message("set_zoom_factor()", "Zoom level now %d (%i/%i)", zoom_factor, zoom_num[zoom_factor], zoom_den[zoom_factor] );
+		zoom_generation ++;
 		rezoom();
+		prezoom_restart();
 	}
 }
 
@@ -1166,10 +1392,439 @@ PIXVAL inline zoomin_pixel(uint8 *p, uint8* pab, uint8 *prl, uint8* pdia)
 
 
 /**
- * Convert base image data to actual image size
+ * Resamples the base data of image @p n for the zoom factor @p zf (not ZOOM_NEUTRAL).
+ * Uses the buffers of rezoom_img_mutex[n % env_t::num_threads], which must be locked.
  * Uses averages of all sampled points to get the "real" value
  * Blurs a bit
  */
+static void zoom_img_data(const image_id n, const int zf, zoomed_img_t &out)
+{
+	out.len = 0;
+	out.data = NULL;
+
+	// now we want to downsize the image
+	// just divide the sizes
+	out.x = (images[n].base_x * zoom_num[zf]) / zoom_den[zf];
+	out.y = (images[n].base_y * zoom_num[zf]) / zoom_den[zf];
+	out.w = (images[n].base_w * zoom_num[zf]) / zoom_den[zf];
+	out.h = (images[n].base_h * zoom_num[zf]) / zoom_den[zf];
+
+	if(  out.h > 0  &&  out.w > 0  ) {
+		// just recalculate the image in the new size
+		PIXVAL *src = images[n].base_data;
+		PIXVAL *dest = NULL;
+		// embed the baseimage in an image with margin ~ remainder
+		const sint16 x_rem = (images[n].base_x * zoom_num[zf]) % zoom_den[zf];
+		const sint16 y_rem = (images[n].base_y * zoom_num[zf]) % zoom_den[zf];
+		const sint16 xl_margin = max( x_rem, 0);
+		const sint16 xr_margin = max(-x_rem, 0);
+		const sint16 yl_margin = max( y_rem, 0);
+		const sint16 yr_margin = max(-y_rem, 0);
+		// baseimage top-left  corner is at (xl_margin, yl_margin)
+		// ...       low-right corner is at (xr_margin, yr_margin)
+
+		sint32 orgzoomwidth = ((images[n].base_w + zoom_den[zf] - 1 ) / zoom_den[zf]) * zoom_den[zf];
+		sint32 newzoomwidth = (orgzoomwidth*zoom_num[zf])/zoom_den[zf];
+		sint32 orgzoomheight = ((images[n].base_h + zoom_den[zf] - 1 ) / zoom_den[zf]) * zoom_den[zf];
+		sint32 newzoomheight = (orgzoomheight * zoom_num[zf]) / zoom_den[zf];
+
+		// we will unpack, re-sample, pack it
+
+		// thus the unpack buffer must at least fit the window => find out maximum size
+		// Note: This value is certainly way bigger than the average size we'll get,
+		// but it's the worst scenario possible, a succession of solid - transparent - solid - transparent
+		// pattern.
+		// This would encode EACH LINE as:
+		// 0x0000 (0 transparent) 0x0001 PIXWORD 0x0001 (every 2 pixels, 3 words) 0x0000 (EOL)
+		// The extra +1 is to make sure we cover divisions with module != 0
+		// We end with an over sized buffer for the normal usage, but since it's re-used for all re-zooms,
+		// it's not performance critical and we are safe from all possible inputs.
+
+		size_t new_size = ( ( (newzoomwidth * 3) / 2 ) + 1 + 2) * newzoomheight * sizeof(PIXVAL);
+		size_t unpack_size = (xl_margin + orgzoomwidth + xr_margin) * (yl_margin + orgzoomheight + yr_margin) * 4;
+		if(  unpack_size > new_size  ) {
+			new_size = unpack_size;
+		}
+		new_size = ((new_size * 128) + 127) / 128; // enlarge slightly to try and keep buffers on their own cacheline for multithreaded access. A portable aligned_alloc would be better.
+		if(  rezoom_size[n % env_t::num_threads] < new_size  ) {
+			free( rezoom_baseimage2[n % env_t::num_threads] );
+			free( rezoom_baseimage[n % env_t::num_threads] );
+			rezoom_size[n % env_t::num_threads] = new_size;
+			rezoom_baseimage[n % env_t::num_threads]  = MALLOCN( uint8, new_size );
+			rezoom_baseimage2[n % env_t::num_threads] = (PIXVAL *)MALLOCN( uint8, new_size );
+		}
+		memset( rezoom_baseimage[n % env_t::num_threads], 255, new_size ); // fill with invalid data to mark transparent regions
+
+		// index of top-left corner
+		uint32 baseoff = 4 * (yl_margin * (xl_margin + orgzoomwidth + xr_margin) + xl_margin);
+		sint32 basewidth = xl_margin + orgzoomwidth + xr_margin;
+
+		// now: unpack the image
+		for(  sint32 y = 0;  y < images[n].base_h;  ++y  ) {
+			uint16 runlen;
+			uint8 *p = rezoom_baseimage[n % env_t::num_threads] + baseoff + y * (basewidth * 4);
+
+			// decode line
+			runlen = *src++;
+			do {
+				// clear run
+				p += (runlen & ~TRANSPARENT_RUN) * 4;
+				// color pixel
+				runlen = (*src++) & ~TRANSPARENT_RUN;
+				while(  runlen--  ) {
+					// get rgb components
+					PIXVAL s = *src++;
+					*p++ = (s>>15);
+					*p++ = (s & 31);
+					s >>= 5;
+					*p++ = (s & 31);
+					s >>= 5;
+					*p++ = (s & 31);
+				}
+				runlen = *src++;
+			} while(  runlen != 0  );
+		}
+
+		// now we have the image, we do a repack then
+		dest = rezoom_baseimage2[n % env_t::num_threads];
+		switch(  zoom_den[zf]  ) {
+			case 1: {
+				assert(zoom_num[zf]==2);
+
+				// first half row - just copy values, do not fiddle with neighbor colors
+				uint8 *p1 = rezoom_baseimage[n % env_t::num_threads] + baseoff;
+				for(  sint16 x = 0;  x < orgzoomwidth;  x++  ) {
+					PIXVAL c1 = compress_pixel_transparent( p1 + (x * 4) );
+					// now set the pixel ...
+					dest[x * 2] = c1;
+					dest[x * 2 + 1] = c1;
+				}
+				// skip one line
+				dest += newzoomwidth;
+
+				for(  sint16 y = 0;  y < orgzoomheight - 1;  y++  ) {
+					uint8 *p1 = rezoom_baseimage[n % env_t::num_threads] + baseoff + y * (basewidth * 4);
+					// copy leftmost pixels
+					dest[0] = compress_pixel_transparent( p1 );
+					dest[newzoomwidth] = compress_pixel_transparent( p1 + basewidth * 4 );
+					for(  sint16 x = 0;  x < orgzoomwidth - 1;  x++  ) {
+						uint8 *px1 = p1 + (x * 4);
+						// pixel at 2,2 in 2x2 superpixel
+						dest[x * 2 + 1] = zoomin_pixel( px1, px1 + 4, px1 + basewidth * 4, px1 + basewidth * 4 + 4 );
+
+						// 2x2 superpixel is transparent but original pixel was not
+						// preserve one pixel
+						if(  dest[x * 2 + 1] == 0x73FE  &&  px1[0] != 255  &&  dest[x * 2] == 0x73FE  &&  dest[x * 2 - newzoomwidth] == 0x73FE  &&  dest[x * 2 - newzoomwidth - 1] == 0x73FE  ) {
+							// preserve one pixel
+							dest[x * 2 + 1] = compress_pixel( px1 );
+						}
+
+						// pixel at 2,1 in next 2x2 superpixel
+						dest[x * 2 + 2] = zoomin_pixel( px1 + 4, px1, px1 + basewidth * 4 + 4, px1 + basewidth * 4 );
+
+						// pixel at 1,2 in next row 2x2 superpixel
+						dest[x * 2 + newzoomwidth + 1] = zoomin_pixel( px1 + basewidth * 4, px1 + basewidth * 4 + 4, px1, px1 + 4 );
+
+						// pixel at 1,1 in next row next 2x2 superpixel
+						dest[x * 2 + newzoomwidth + 2] = zoomin_pixel( px1 + basewidth * 4 + 4, px1 + basewidth * 4, px1 + 4, px1 );
+					}
+					// copy rightmost pixels
+					dest[2 * orgzoomwidth - 1] = compress_pixel_transparent( p1 + 4 * (orgzoomwidth - 1) );
+					dest[2 * orgzoomwidth + newzoomwidth - 1] = compress_pixel_transparent( p1 + 4 * (orgzoomwidth - 1) + basewidth * 4 );
+					// skip two lines
+					dest += 2 * newzoomwidth;
+				}
+				// last half row - just copy values, do not fiddle with neighbor colors
+				p1 = rezoom_baseimage[n % env_t::num_threads] + baseoff + (orgzoomheight - 1) * (basewidth * 4);
+				for(  sint16 x = 0;  x < orgzoomwidth;  x++  ) {
+					PIXVAL c1 = compress_pixel_transparent( p1 + (x * 4) );
+					// now set the pixel ...
+					dest[x * 2]   = c1;
+					dest[x * 2 + 1] = c1;
+				}
+				break;
+			}
+			case 2:
+				for(  sint16 y = 0;  y < newzoomheight;  y++  ) {
+					uint8 *p1 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zf] + 0 - y_rem) / zoom_num[zf]) * (basewidth * 4);
+					uint8 *p2 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zf] + 1 - y_rem) / zoom_num[zf]) * (basewidth * 4);
+					for(  sint16 x = 0;  x < newzoomwidth;  x++  ) {
+						uint8 valid = 0;
+						uint8 r = 0, g = 0, b = 0;
+						sint16 xreal1 = ((x * zoom_den[zf] + 0 - x_rem) / zoom_num[zf]) * 4;
+						sint16 xreal2 = ((x * zoom_den[zf] + 1 - x_rem) / zoom_num[zf]) * 4;
+						SumSubpixel( p1 + xreal1 );
+						SumSubpixel( p1 + xreal2 );
+						SumSubpixel( p2 + xreal1 );
+						SumSubpixel( p2 + xreal2 );
+						if(  valid == 0  ) {
+							*dest++ = 0x73FE;
+						}
+						else if(  valid == 255  ) {
+							*dest++ = (0x8000 | r) + (((uint16)g)<<5) + (((uint16)b)<<10);
+						}
+						else {
+							*dest++ = (r/valid) + (((uint16)(g/valid))<<5) + (((uint16)(b/valid))<<10);
+						}
+					}
+				}
+				break;
+			case 3:
+				for(  sint16 y = 0;  y < newzoomheight;  y++  ) {
+					uint8 *p1 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zf] + 0 - y_rem) / zoom_num[zf]) * (basewidth * 4);
+					uint8 *p2 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zf] + 1 - y_rem) / zoom_num[zf]) * (basewidth * 4);
+					uint8 *p3 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zf] + 2 - y_rem) / zoom_num[zf]) * (basewidth * 4);
+					for(  sint16 x = 0;  x < newzoomwidth;  x++  ) {
+						uint8 valid = 0;
+						uint16 r = 0, g = 0, b = 0;
+						sint16 xreal1 = ((x * zoom_den[zf] + 0 - x_rem) / zoom_num[zf]) * 4;
+						sint16 xreal2 = ((x * zoom_den[zf] + 1 - x_rem) / zoom_num[zf]) * 4;
+						sint16 xreal3 = ((x * zoom_den[zf] + 2 - x_rem) / zoom_num[zf]) * 4;
+						SumSubpixel( p1 + xreal1 );
+						SumSubpixel( p1 + xreal2 );
+						SumSubpixel( p1 + xreal3 );
+						SumSubpixel( p2 + xreal1 );
+						SumSubpixel( p2 + xreal2 );
+						SumSubpixel( p2 + xreal3 );
+						SumSubpixel( p3 + xreal1 );
+						SumSubpixel( p3 + xreal2 );
+						SumSubpixel( p3 + xreal3 );
+						if(  valid == 0  ) {
+							*dest++ = 0x73FE;
+						}
+						else if(  valid == 255  ) {
+							*dest++ = (0x8000 | r) + (((uint16)g)<<5) + (((uint16)b)<<10);
+						}
+						else {
+							*dest++ = (r/valid) | (((uint16)(g/valid))<<5) | (((uint16)(b/valid))<<10);
+						}
+					}
+				}
+				break;
+			case 4:
+				for(  sint16 y = 0;  y < newzoomheight;  y++  ) {
+					uint8 *p1 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zf] + 0 - y_rem) / zoom_num[zf]) * (basewidth * 4);
+					uint8 *p2 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zf] + 1 - y_rem) / zoom_num[zf]) * (basewidth * 4);
+					uint8 *p3 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zf] + 2 - y_rem) / zoom_num[zf]) * (basewidth * 4);
+					uint8 *p4 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zf] + 3 - y_rem) / zoom_num[zf]) * (basewidth * 4);
+					for(  sint16 x = 0;  x < newzoomwidth;  x++  ) {
+						uint8 valid = 0;
+						uint16 r = 0, g = 0, b = 0;
+						sint16 xreal1 = ((x * zoom_den[zf] + 0 - x_rem) / zoom_num[zf]) * 4;
+						sint16 xreal2 = ((x * zoom_den[zf] + 1 - x_rem) / zoom_num[zf]) * 4;
+						sint16 xreal3 = ((x * zoom_den[zf] + 2 - x_rem) / zoom_num[zf]) * 4;
+						sint16 xreal4 = ((x * zoom_den[zf] + 3 - x_rem) / zoom_num[zf]) * 4;
+						SumSubpixel( p1 + xreal1 );
+						SumSubpixel( p1 + xreal2 );
+						SumSubpixel( p1 + xreal3 );
+						SumSubpixel( p1 + xreal4 );
+						SumSubpixel( p2 + xreal1 );
+						SumSubpixel( p2 + xreal2 );
+						SumSubpixel( p2 + xreal3 );
+						SumSubpixel( p2 + xreal4 );
+						SumSubpixel( p3 + xreal1 );
+						SumSubpixel( p3 + xreal2 );
+						SumSubpixel( p3 + xreal3 );
+						SumSubpixel( p3 + xreal4 );
+						SumSubpixel( p4 + xreal1 );
+						SumSubpixel( p4 + xreal2 );
+						SumSubpixel( p4 + xreal3 );
+						SumSubpixel( p4 + xreal4 );
+						if(  valid == 0  ) {
+							*dest++ = 0x73FE;
+						}
+						else if(  valid == 255  ) {
+							*dest++ = (0x8000 | r) + (((uint16)g)<<5) + (((uint16)b)<<10);
+						}
+						else {
+							*dest++ = (r/valid) | (((uint16)(g/valid))<<5) | (((uint16)(b/valid))<<10);
+						}
+					}
+				}
+				break;
+			case 8:
+				for(  sint16 y = 0;  y < newzoomheight;  y++  ) {
+					uint8 *p1 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zf] + 0 - y_rem) / zoom_num[zf]) * (basewidth * 4);
+					uint8 *p2 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zf] + 1 - y_rem) / zoom_num[zf]) * (basewidth * 4);
+					uint8 *p3 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zf] + 2 - y_rem) / zoom_num[zf]) * (basewidth * 4);
+					uint8 *p4 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zf] + 3 - y_rem) / zoom_num[zf]) * (basewidth * 4);
+					uint8 *p5 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zf] + 4 - y_rem) / zoom_num[zf]) * (basewidth * 4);
+					uint8 *p6 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zf] + 5 - y_rem) / zoom_num[zf]) * (basewidth * 4);
+					uint8 *p7 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zf] + 6 - y_rem) / zoom_num[zf]) * (basewidth * 4);
+					uint8 *p8 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zf] + 7 - y_rem) / zoom_num[zf]) * (basewidth * 4);
+					for(  sint16 x = 0;  x < newzoomwidth;  x++  ) {
+						uint8 valid = 0;
+						uint16 r = 0, g = 0, b = 0;
+						sint16 xreal1 = ((x * zoom_den[zf] + 0 - x_rem) / zoom_num[zf]) * 4;
+						sint16 xreal2 = ((x * zoom_den[zf] + 1 - x_rem) / zoom_num[zf]) * 4;
+						sint16 xreal3 = ((x * zoom_den[zf] + 2 - x_rem) / zoom_num[zf]) * 4;
+						sint16 xreal4 = ((x * zoom_den[zf] + 3 - x_rem) / zoom_num[zf]) * 4;
+						sint16 xreal5 = ((x * zoom_den[zf] + 4 - x_rem) / zoom_num[zf]) * 4;
+						sint16 xreal6 = ((x * zoom_den[zf] + 5 - x_rem) / zoom_num[zf]) * 4;
+						sint16 xreal7 = ((x * zoom_den[zf] + 6 - x_rem) / zoom_num[zf]) * 4;
+						sint16 xreal8 = ((x * zoom_den[zf] + 7 - x_rem) / zoom_num[zf]) * 4;
+						SumSubpixel( p1 + xreal1 );
+						SumSubpixel( p1 + xreal2 );
+						SumSubpixel( p1 + xreal3 );
+						SumSubpixel( p1 + xreal4 );
+						SumSubpixel( p1 + xreal5 );
+						SumSubpixel( p1 + xreal6 );
+						SumSubpixel( p1 + xreal7 );
+						SumSubpixel( p1 + xreal8 );
+						SumSubpixel( p2 + xreal1 );
+						SumSubpixel( p2 + xreal2 );
+						SumSubpixel( p2 + xreal3 );
+						SumSubpixel( p2 + xreal4 );
+						SumSubpixel( p2 + xreal5 );
+						SumSubpixel( p2 + xreal6 );
+						SumSubpixel( p2 + xreal7 );
+						SumSubpixel( p2 + xreal8 );
+						SumSubpixel( p3 + xreal1 );
+						SumSubpixel( p3 + xreal2 );
+						SumSubpixel( p3 + xreal3 );
+						SumSubpixel( p3 + xreal4 );
+						SumSubpixel( p3 + xreal5 );
+						SumSubpixel( p3 + xreal6 );
+						SumSubpixel( p3 + xreal7 );
+						SumSubpixel( p3 + xreal8 );
+						SumSubpixel( p4 + xreal1 );
+						SumSubpixel( p4 + xreal2 );
+						SumSubpixel( p4 + xreal3 );
+						SumSubpixel( p4 + xreal4 );
+						SumSubpixel( p4 + xreal5 );
+						SumSubpixel( p4 + xreal6 );
+						SumSubpixel( p4 + xreal7 );
+						SumSubpixel( p4 + xreal8 );
+						SumSubpixel( p5 + xreal1 );
+						SumSubpixel( p5 + xreal2 );
+						SumSubpixel( p5 + xreal3 );
+						SumSubpixel( p5 + xreal4 );
+						SumSubpixel( p5 + xreal5 );
+						SumSubpixel( p5 + xreal6 );
+						SumSubpixel( p5 + xreal7 );
+						SumSubpixel( p5 + xreal8 );
+						SumSubpixel( p6 + xreal1 );
+						SumSubpixel( p6 + xreal2 );
+						SumSubpixel( p6 + xreal3 );
+						SumSubpixel( p6 + xreal4 );
+						SumSubpixel( p6 + xreal5 );
+						SumSubpixel( p6 + xreal6 );
+						SumSubpixel( p6 + xreal7 );
+						SumSubpixel( p6 + xreal8 );
+						SumSubpixel( p7 + xreal1 );
+						SumSubpixel( p7 + xreal2 );
+						SumSubpixel( p7 + xreal3 );
+						SumSubpixel( p7 + xreal4 );
+						SumSubpixel( p7 + xreal5 );
+						SumSubpixel( p7 + xreal6 );
+						SumSubpixel( p7 + xreal7 );
+						SumSubpixel( p7 + xreal8 );
+						SumSubpixel( p8 + xreal1 );
+						SumSubpixel( p8 + xreal2 );
+						SumSubpixel( p8 + xreal3 );
+						SumSubpixel( p8 + xreal4 );
+						SumSubpixel( p8 + xreal5 );
+						SumSubpixel( p8 + xreal6 );
+						SumSubpixel( p8 + xreal7 );
+						SumSubpixel( p8 + xreal8 );
+						if(  valid == 0  ) {
+							*dest++ = 0x73FE;
+						}
+						else if(  valid == 255  ) {
+							*dest++ = (0x8000 | r) + (((uint16)g)<<5) + (((uint16)b)<<10);
+						}
+						else {
+							*dest++ = (r/valid) | (((uint16)(g/valid))<<5) | (((uint16)(b/valid))<<10);
+						}
+					}
+				}
+				break;
+			default: assert(0);
+		}
+
+		// now encode the image again
+		dest = (PIXVAL*)rezoom_baseimage[n % env_t::num_threads];
+		for(  sint16 y = 0;  y < newzoomheight;  y++  ) {
+			PIXVAL *line = ((PIXVAL *)rezoom_baseimage2[n % env_t::num_threads]) + (y * newzoomwidth);
+			PIXVAL count;
+			sint16 x = 0;
+			uint16 clear_colored_run_pair_count = 0;
+
+			do {
+				// check length of transparent pixels
+				for(  count = 0;  x < newzoomwidth  &&  line[x] == 0x73FE;  count++, x++  )
+					{}
+				// first runlength: transparent pixels
+				*dest++ = count;
+				uint16 has_alpha = 0;
+				// copy for non-transparent
+				count = 0;
+				while(  x < newzoomwidth  &&  line[x] != 0x73FE  ) {
+					PIXVAL pixval = line[x++];
+					if(  pixval >= 0x8020  &&  !has_alpha  ) {
+						if(  count  ) {
+							*dest++ = count;
+							dest += count;
+							count = 0;
+							*dest++ = TRANSPARENT_RUN;
+						}
+						has_alpha = TRANSPARENT_RUN;
+					}
+					else if(  pixval < 0x8020  &&  has_alpha  ) {
+						if(  count  ) {
+							*dest++ = count+TRANSPARENT_RUN;
+							dest += count;
+							count = 0;
+							*dest++ = TRANSPARENT_RUN;
+						}
+						has_alpha = 0;
+					}
+					count++;
+					dest[count] = pixval;
+				}
+
+				/*
+				 * If it is not the first clear-colored-run pair and its colored run is empty
+				 * --> it is superfluous and can be removed by rolling back the pointer
+				 */
+				if(  clear_colored_run_pair_count > 0  &&  count == 0  ) {
+					dest--;
+					// this only happens at the end of a line, so no need to increment clear_colored_run_pair_count
+				}
+				else {
+					*dest++ = count+has_alpha; // number of colored pixels
+					dest += count; // skip them
+					clear_colored_run_pair_count++;
+				}
+			} while(  x < newzoomwidth  );
+			*dest++ = 0; // mark line end
+		}
+
+		// something left?
+		out.w = newzoomwidth;
+		out.h = newzoomheight;
+		if(  newzoomheight > 0  ) {
+			const size_t zoom_len = (size_t)(((uint8 *)dest) - ((uint8 *)rezoom_baseimage[n % env_t::num_threads]));
+			out.len = (uint32)(zoom_len / sizeof(PIXVAL));
+			out.data = MALLOCN(PIXVAL, out.len);
+			assert( out.data );
+			memcpy( out.data, rezoom_baseimage[n % env_t::num_threads], zoom_len );
+		}
+	}
+	else {
+//			if (images[n].w <= 0) {
+//				// h=0 will be ignored, with w=0 there was an error!
+//				printf("WARNING: image%d w=0!\n", n);
+//			}
+		out.h = 0;
+	}
+}
+
+
+/**
+ * Convert base image data to actual image size,
+ * from the prezoom cache if possible.
+ */
 static void rezoom_img(const image_id n)
 {
 	// may this image be zoomed
@@ -1186,11 +1841,21 @@ static void rezoom_img(const image_id n)
 		images[n].player_flags = 0xFFFF; // recode all player colors
 
 		//  we recalculate the len (since it may be larger than before)
-		// thus we have to free the old caches
+		// thus we have to free the old caches, but keep the zoomed data in case we zoom back
 		if(  images[n].zoom_data != NULL  ) {
-			free( images[n].zoom_data );
+			zoomed_img_t old;
+			old.x = images[n].x;
+			old.y = images[n].y;
+			old.w = images[n].w;
+			old.h = images[n].h;
+			old.len = images[n].len;
+			old.data = images[n].zoom_data;
+			if(  !prezoom_store( n, images[n].zoom_level, old )  ) {
+				free( images[n].zoom_data );
+			}
 			images[n].zoom_data = NULL;
 		}
+		images[n].zoom_level = -1;
 		for(  uint8 i = 0;  i < MAX_PLAYER_COUNT;  i++  ) {
 			if(  images[n].data[i] != NULL  ) {
 				free( images[n].data[i] );
@@ -1219,6 +1884,7 @@ static void rezoom_img(const image_id n)
 				sp++;
 			}
 			images[n].len = (uint32)(size_t)(sp - images[n].base_data);
+			images[n].zoom_generation = zoom_generation;
 			images[n].recode_flags &= ~FLAG_REZOOM;
 #ifdef MULTI_THREAD
 			pthread_mutex_unlock( &rezoom_img_mutex[n % env_t::num_threads] );
@@ -1226,422 +1892,20 @@ static void rezoom_img(const image_id n)
 			return;
 		}
 
-		// now we want to downsize the image
-		// just divide the sizes
-		images[n].x = (images[n].base_x * zoom_num[zoom_factor]) / zoom_den[zoom_factor];
-		images[n].y = (images[n].base_y * zoom_num[zoom_factor]) / zoom_den[zoom_factor];
-		images[n].w = (images[n].base_w * zoom_num[zoom_factor]) / zoom_den[zoom_factor];
-		images[n].h = (images[n].base_h * zoom_num[zoom_factor]) / zoom_den[zoom_factor];
-
-		if(  images[n].h > 0  &&  images[n].w > 0  ) {
-			// just recalculate the image in the new size
-			PIXVAL *src = images[n].base_data;
-			PIXVAL *dest = NULL;
-			// embed the baseimage in an image with margin ~ remainder
-			const sint16 x_rem = (images[n].base_x * zoom_num[zoom_factor]) % zoom_den[zoom_factor];
-			const sint16 y_rem = (images[n].base_y * zoom_num[zoom_factor]) % zoom_den[zoom_factor];
-			const sint16 xl_margin = max( x_rem, 0);
-			const sint16 xr_margin = max(-x_rem, 0);
-			const sint16 yl_margin = max( y_rem, 0);
-			const sint16 yr_margin = max(-y_rem, 0);
-			// baseimage top-left  corner is at (xl_margin, yl_margin)
-			// ...       low-right corner is at (xr_margin, yr_margin)
-
-			sint32 orgzoomwidth = ((images[n].base_w + zoom_den[zoom_factor] - 1 ) / zoom_den[zoom_factor]) * zoom_den[zoom_factor];
-			sint32 newzoomwidth = (orgzoomwidth*zoom_num[zoom_factor])/zoom_den[zoom_factor];
-			sint32 orgzoomheight = ((images[n].base_h + zoom_den[zoom_factor] - 1 ) / zoom_den[zoom_factor]) * zoom_den[zoom_factor];
-			sint32 newzoomheight = (orgzoomheight * zoom_num[zoom_factor]) / zoom_den[zoom_factor];
-
-			// we will unpack, re-sample, pack it
-
-			// thus the unpack buffer must at least fit the window => find out maximum size
-			// Note: This value is certainly way bigger than the average size we'll get,
-			// but it's the worst scenario possible, a succession of solid - transparent - solid - transparent
-			// pattern.
-			// This would encode EACH LINE as:
-			// 0x0000 (0 transparent) 0x0001 PIXWORD 0x0001 (every 2 pixels, 3 words) 0x0000 (EOL)
-			// The extra +1 is to make sure we cover divisions with module != 0
-			// We end with an over sized buffer for the normal usage, but since it's re-used for all re-zooms,
-			// it's not performance critical and we are safe from all possible inputs.
-
-			size_t new_size = ( ( (newzoomwidth * 3) / 2 ) + 1 + 2) * newzoomheight * sizeof(PIXVAL);
-			size_t unpack_size = (xl_margin + orgzoomwidth + xr_margin) * (yl_margin + orgzoomheight + yr_margin) * 4;
-			if(  unpack_size > new_size  ) {
-				new_size = unpack_size;
-			}
-			new_size = ((new_size * 128) + 127) / 128; // enlarge slightly to try and keep buffers on their own cacheline for multithreaded access. A portable aligned_alloc would be better.
-			if(  rezoom_size[n % env_t::num_threads] < new_size  ) {
-				free( rezoom_baseimage2[n % env_t::num_threads] );
-				free( rezoom_baseimage[n % env_t::num_threads] );
-				rezoom_size[n % env_t::num_threads] = new_size;
-				rezoom_baseimage[n % env_t::num_threads]  = MALLOCN( uint8, new_size );
-				rezoom_baseimage2[n % env_t::num_threads] = (PIXVAL *)MALLOCN( uint8, new_size );
-			}
-			memset( rezoom_baseimage[n % env_t::num_threads], 255, new_size ); // fill with invalid data to mark transparent regions
-
-			// index of top-left corner
-			uint32 baseoff = 4 * (yl_margin * (xl_margin + orgzoomwidth + xr_margin) + xl_margin);
-			sint32 basewidth = xl_margin + orgzoomwidth + xr_margin;
-
-			// now: unpack the image
-			for(  sint32 y = 0;  y < images[n].base_h;  ++y  ) {
-				uint16 runlen;
-				uint8 *p = rezoom_baseimage[n % env_t::num_threads] + baseoff + y * (basewidth * 4);
-
-				// decode line
-				runlen = *src++;
-				do {
-					// clear run
-					p += (runlen & ~TRANSPARENT_RUN) * 4;
-					// color pixel
-					runlen = (*src++) & ~TRANSPARENT_RUN;
-					while(  runlen--  ) {
-						// get rgb components
-						PIXVAL s = *src++;
-						*p++ = (s>>15);
-						*p++ = (s & 31);
-						s >>= 5;
-						*p++ = (s & 31);
-						s >>= 5;
-						*p++ = (s & 31);
-					}
-					runlen = *src++;
-				} while(  runlen != 0  );
-			}
-
-			// now we have the image, we do a repack then
-			dest = rezoom_baseimage2[n % env_t::num_threads];
-			switch(  zoom_den[zoom_factor]  ) {
-				case 1: {
-					assert(zoom_num[zoom_factor]==2);
-
-					// first half row - just copy values, do not fiddle with neighbor colors
-					uint8 *p1 = rezoom_baseimage[n % env_t::num_threads] + baseoff;
-					for(  sint16 x = 0;  x < orgzoomwidth;  x++  ) {
-						PIXVAL c1 = compress_pixel_transparent( p1 + (x * 4) );
-						// now set the pixel ...
-						dest[x * 2] = c1;
-						dest[x * 2 + 1] = c1;
-					}
-					// skip one line
-					dest += newzoomwidth;
-
-					for(  sint16 y = 0;  y < orgzoomheight - 1;  y++  ) {
-						uint8 *p1 = rezoom_baseimage[n % env_t::num_threads] + baseoff + y * (basewidth * 4);
-						// copy leftmost pixels
-						dest[0] = compress_pixel_transparent( p1 );
-						dest[newzoomwidth] = compress_pixel_transparent( p1 + basewidth * 4 );
-						for(  sint16 x = 0;  x < orgzoomwidth - 1;  x++  ) {
-							uint8 *px1 = p1 + (x * 4);
-							// pixel at 2,2 in 2x2 superpixel
-							dest[x * 2 + 1] = zoomin_pixel( px1, px1 + 4, px1 + basewidth * 4, px1 + basewidth * 4 + 4 );
-
-							// 2x2 superpixel is transparent but original pixel was not
-							// preserve one pixel
-							if(  dest[x * 2 + 1] == 0x73FE  &&  px1[0] != 255  &&  dest[x * 2] == 0x73FE  &&  dest[x * 2 - newzoomwidth] == 0x73FE  &&  dest[x * 2 - newzoomwidth - 1] == 0x73FE  ) {
-								// preserve one pixel
-								dest[x * 2 + 1] = compress_pixel( px1 );
-							}
-
-							// pixel at 2,1 in next 2x2 superpixel
-							dest[x * 2 + 2] = zoomin_pixel( px1 + 4, px1, px1 + basewidth * 4 + 4, px1 + basewidth * 4 );
-
-							// pixel at 1,2 in next row 2x2 superpixel
-							dest[x * 2 + newzoomwidth + 1] = zoomin_pixel( px1 + basewidth * 4, px1 + basewidth * 4 + 4, px1, px1 + 4 );
-
-							// pixel at 1,1 in next row next 2x2 superpixel
-							dest[x * 2 + newzoomwidth + 2] = zoomin_pixel( px1 + basewidth * 4 + 4, px1 + basewidth * 4, px1 + 4, px1 );
-						}
-						// copy rightmost pixels
-						dest[2 * orgzoomwidth - 1] = compress_pixel_transparent( p1 + 4 * (orgzoomwidth - 1) );
-						dest[2 * orgzoomwidth + newzoomwidth - 1] = compress_pixel_transparent( p1 + 4 * (orgzoomwidth - 1) + basewidth * 4 );
-						// skip two lines
-						dest += 2 * newzoomwidth;
-					}
-					// last half row - just copy values, do not fiddle with neighbor colors
-					p1 = rezoom_baseimage[n % env_t::num_threads] + baseoff + (orgzoomheight - 1) * (basewidth * 4);
-					for(  sint16 x = 0;  x < orgzoomwidth;  x++  ) {
-						PIXVAL c1 = compress_pixel_transparent( p1 + (x * 4) );
-						// now set the pixel ...
-						dest[x * 2]   = c1;
-						dest[x * 2 + 1] = c1;
-					}
-					break;
-				}
-				case 2:
-					for(  sint16 y = 0;  y < newzoomheight;  y++  ) {
-						uint8 *p1 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zoom_factor] + 0 - y_rem) / zoom_num[zoom_factor]) * (basewidth * 4);
-						uint8 *p2 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zoom_factor] + 1 - y_rem) / zoom_num[zoom_factor]) * (basewidth * 4);
-						for(  sint16 x = 0;  x < newzoomwidth;  x++  ) {
-							uint8 valid = 0;
-							uint8 r = 0, g = 0, b = 0;
-							sint16 xreal1 = ((x * zoom_den[zoom_factor] + 0 - x_rem) / zoom_num[zoom_factor]) * 4;
-							sint16 xreal2 = ((x * zoom_den[zoom_factor] + 1 - x_rem) / zoom_num[zoom_factor]) * 4;
-							SumSubpixel( p1 + xreal1 );
-							SumSubpixel( p1 + xreal2 );
-							SumSubpixel( p2 + xreal1 );
-							SumSubpixel( p2 + xreal2 );
-							if(  valid == 0  ) {
-								*dest++ = 0x73FE;
-							}
-							else if(  valid == 255  ) {
-								*dest++ = (0x8000 | r) + (((uint16)g)<<5) + (((uint16)b)<<10);
-							}
-							else {
-								*dest++ = (r/valid) + (((uint16)(g/valid))<<5) + (((uint16)(b/valid))<<10);
-							}
-						}
-					}
-					break;
-				case 3:
-					for(  sint16 y = 0;  y < newzoomheight;  y++  ) {
-						uint8 *p1 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zoom_factor] + 0 - y_rem) / zoom_num[zoom_factor]) * (basewidth * 4);
-						uint8 *p2 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zoom_factor] + 1 - y_rem) / zoom_num[zoom_factor]) * (basewidth * 4);
-						uint8 *p3 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zoom_factor] + 2 - y_rem) / zoom_num[zoom_factor]) * (basewidth * 4);
-						for(  sint16 x = 0;  x < newzoomwidth;  x++  ) {
-							uint8 valid = 0;
-							uint16 r = 0, g = 0, b = 0;
-							sint16 xreal1 = ((x * zoom_den[zoom_factor] + 0 - x_rem) / zoom_num[zoom_factor]) * 4;
-							sint16 xreal2 = ((x * zoom_den[zoom_factor] + 1 - x_rem) / zoom_num[zoom_factor]) * 4;
-							sint16 xreal3 = ((x * zoom_den[zoom_factor] + 2 - x_rem) / zoom_num[zoom_factor]) * 4;
-							SumSubpixel( p1 + xreal1 );
-							SumSubpixel( p1 + xreal2 );
-							SumSubpixel( p1 + xreal3 );
-							SumSubpixel( p2 + xreal1 );
-							SumSubpixel( p2 + xreal2 );
-							SumSubpixel( p2 + xreal3 );
-							SumSubpixel( p3 + xreal1 );
-							SumSubpixel( p3 + xreal2 );
-							SumSubpixel( p3 + xreal3 );
-							if(  valid == 0  ) {
-								*dest++ = 0x73FE;
-							}
-							else if(  valid == 255  ) {
-								*dest++ = (0x8000 | r) + (((uint16)g)<<5) + (((uint16)b)<<10);
-							}
-							else {
-								*dest++ = (r/valid) | (((uint16)(g/valid))<<5) | (((uint16)(b/valid))<<10);
-							}
-						}
-					}
-					break;
-				case 4:
-					for(  sint16 y = 0;  y < newzoomheight;  y++  ) {
-						uint8 *p1 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zoom_factor] + 0 - y_rem) / zoom_num[zoom_factor]) * (basewidth * 4);
-						uint8 *p2 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zoom_factor] + 1 - y_rem) / zoom_num[zoom_factor]) * (basewidth * 4);
-						uint8 *p3 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zoom_factor] + 2 - y_rem) / zoom_num[zoom_factor]) * (basewidth * 4);
-						uint8 *p4 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zoom_factor] + 3 - y_rem) / zoom_num[zoom_factor]) * (basewidth * 4);
-						for(  sint16 x = 0;  x < newzoomwidth;  x++  ) {
-							uint8 valid = 0;
-							uint16 r = 0, g = 0, b = 0;
-							sint16 xreal1 = ((x * zoom_den[zoom_factor] + 0 - x_rem) / zoom_num[zoom_factor]) * 4;
-							sint16 xreal2 = ((x * zoom_den[zoom_factor] + 1 - x_rem) / zoom_num[zoom_factor]) * 4;
-							sint16 xreal3 = ((x * zoom_den[zoom_factor] + 2 - x_rem) / zoom_num[zoom_factor]) * 4;
-							sint16 xreal4 = ((x * zoom_den[zoom_factor] + 3 - x_rem) / zoom_num[zoom_factor]) * 4;
-							SumSubpixel( p1 + xreal1 );
-							SumSubpixel( p1 + xreal2 );
-							SumSubpixel( p1 + xreal3 );
-							SumSubpixel( p1 + xreal4 );
-							SumSubpixel( p2 + xreal1 );
-							SumSubpixel( p2 + xreal2 );
-							SumSubpixel( p2 + xreal3 );
-							SumSubpixel( p2 + xreal4 );
-							SumSubpixel( p3 + xreal1 );
-							SumSubpixel( p3 + xreal2 );
-							SumSubpixel( p3 + xreal3 );
-							SumSubpixel( p3 + xreal4 );
-							SumSubpixel( p4 + xreal1 );
-							SumSubpixel( p4 + xreal2 );
-							SumSubpixel( p4 + xreal3 );
-							SumSubpixel( p4 + xreal4 );
-							if(  valid == 0  ) {
-								*dest++ = 0x73FE;
-							}
-							else if(  valid == 255  ) {
-								*dest++ = (0x8000 | r) + (((uint16)g)<<5) + (((uint16)b)<<10);
-							}
-							else {
-								*dest++ = (r/valid) | (((uint16)(g/valid))<<5) | (((uint16)(b/valid))<<10);
-							}
-						}
-					}
-					break;
-				case 8:
-					for(  sint16 y = 0;  y < newzoomheight;  y++  ) {
-						uint8 *p1 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zoom_factor] + 0 - y_rem) / zoom_num[zoom_factor]) * (basewidth * 4);
-						uint8 *p2 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zoom_factor] + 1 - y_rem) / zoom_num[zoom_factor]) * (basewidth * 4);
-						uint8 *p3 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zoom_factor] + 2 - y_rem) / zoom_num[zoom_factor]) * (basewidth * 4);
-						uint8 *p4 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zoom_factor] + 3 - y_rem) / zoom_num[zoom_factor]) * (basewidth * 4);
-						uint8 *p5 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zoom_factor] + 4 - y_rem) / zoom_num[zoom_factor]) * (basewidth * 4);
-						uint8 *p6 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zoom_factor] + 5 - y_rem) / zoom_num[zoom_factor]) * (basewidth * 4);
-						uint8 *p7 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zoom_factor] + 6 - y_rem) / zoom_num[zoom_factor]) * (basewidth * 4);
-						uint8 *p8 = rezoom_baseimage[n % env_t::num_threads] + baseoff + ((y * zoom_den[zoom_factor] + 7 - y_rem) / zoom_num[zoom_factor]) * (basewidth * 4);
-						for(  sint16 x = 0;  x < newzoomwidth;  x++  ) {
-							uint8 valid = 0;
-							uint16 r = 0, g = 0, b = 0;
-							sint16 xreal1 = ((x * zoom_den[zoom_factor] + 0 - x_rem) / zoom_num[zoom_factor]) * 4;
-							sint16 xreal2 = ((x * zoom_den[zoom_factor] + 1 - x_rem) / zoom_num[zoom_factor]) * 4;
-							sint16 xreal3 = ((x * zoom_den[zoom_factor] + 2 - x_rem) / zoom_num[zoom_factor]) * 4;
-							sint16 xreal4 = ((x * zoom_den[zoom_factor] + 3 - x_rem) / zoom_num[zoom_factor]) * 4;
-							sint16 xreal5 = ((x * zoom_den[zoom_factor] + 4 - x_rem) / zoom_num[zoom_factor]) * 4;
-							sint16 xreal6 = ((x * zoom_den[zoom_factor] + 5 - x_rem) / zoom_num[zoom_factor]) * 4;
-							sint16 xreal7 = ((x * zoom_den[zoom_factor] + 6 - x_rem) / zoom_num[zoom_factor]) * 4;
-							sint16 xreal8 = ((x * zoom_den[zoom_factor] + 7 - x_rem) / zoom_num[zoom_factor]) * 4;
-							SumSubpixel( p1 + xreal1 );
-							SumSubpixel( p1 + xreal2 );
-							SumSubpixel( p1 + xreal3 );
-							SumSubpixel( p1 + xreal4 );
-							SumSubpixel( p1 + xreal5 );
-							SumSubpixel( p1 + xreal6 );
-							SumSubpixel( p1 + xreal7 );
-							SumSubpixel( p1 + xreal8 );
-							SumSubpixel( p2 + xreal1 );
-							SumSubpixel( p2 + xreal2 );
-							SumSubpixel( p2 + xreal3 );
-							SumSubpixel( p2 + xreal4 );
-							SumSubpixel( p2 + xreal5 );
-							SumSubpixel( p2 + xreal6 );
-							SumSubpixel( p2 + xreal7 );
-							SumSubpixel( p2 + xreal8 );
-							SumSubpixel( p3 + xreal1 );
-							SumSubpixel( p3 + xreal2 );
-							SumSubpixel( p3 + xreal3 );
-							SumSubpixel( p3 + xreal4 );
-							SumSubpixel( p3 + xreal5 );
-							SumSubpixel( p3 + xreal6 );
-							SumSubpixel( p3 + xreal7 );
-							SumSubpixel( p3 + xreal8 );
-							SumSubpixel( p4 + xreal1 );
-							SumSubpixel( p4 + xreal2 );
-							SumSubpixel( p4 + xreal3 );
-							SumSubpixel( p4 + xreal4 );
-							SumSubpixel( p4 + xreal5 );
-							SumSubpixel( p4 + xreal6 );
-							SumSubpixel( p4 + xreal7 );
-							SumSubpixel( p4 + xreal8 );
-							SumSubpixel( p5 + xreal1 );
-							SumSubpixel( p5 + xreal2 );
-							SumSubpixel( p5 + xreal3 );
-							SumSubpixel( p5 + xreal4 );
-							SumSubpixel( p5 + xreal5 );
-							SumSubpixel( p5 + xreal6 );
-							SumSubpixel( p5 + xreal7 );
-							SumSubpixel( p5 + xreal8 );
-							SumSubpixel( p6 + xreal1 );
-							SumSubpixel( p6 + xreal2 );
-							SumSubpixel( p6 + xreal3 );
-							SumSubpixel( p6 + xreal4 );
-							SumSubpixel( p6 + xreal5 );
-							SumSubpixel( p6 + xreal6 );
-							SumSubpixel( p6 + xreal7 );
-							SumSubpixel( p6 + xreal8 );
-							SumSubpixel( p7 + xreal1 );
-							SumSubpixel( p7 + xreal2 );
-							SumSubpixel( p7 + xreal3 );
-							SumSubpixel( p7 + xreal4 );
-							SumSubpixel( p7 + xreal5 );
-							SumSubpixel( p7 + xreal6 );
-							SumSubpixel( p7 + xreal7 );
-							SumSubpixel( p7 + xreal8 );
-							SumSubpixel( p8 + xreal1 );
-							SumSubpixel( p8 + xreal2 );
-							SumSubpixel( p8 + xreal3 );
-							SumSubpixel( p8 + xreal4 );
-							SumSubpixel( p8 + xreal5 );
-							SumSubpixel( p8 + xreal6 );
-							SumSubpixel( p8 + xreal7 );
-							SumSubpixel( p8 + xreal8 );
-							if(  valid == 0  ) {
-								*dest++ = 0x73FE;
-							}
-							else if(  valid == 255  ) {
-								*dest++ = (0x8000 | r) + (((uint16)g)<<5) + (((uint16)b)<<10);
-							}
-							else {
-								*dest++ = (r/valid) | (((uint16)(g/valid))<<5) | (((uint16)(b/valid))<<10);
-							}
-						}
-					}
-					break;
-				default: assert(0);
-			}
-
-			// now encode the image again
-			dest = (PIXVAL*)rezoom_baseimage[n % env_t::num_threads];
-			for(  sint16 y = 0;  y < newzoomheight;  y++  ) {
-				PIXVAL *line = ((PIXVAL *)rezoom_baseimage2[n % env_t::num_threads]) + (y * newzoomwidth);
-				PIXVAL count;
-				sint16 x = 0;
-				uint16 clear_colored_run_pair_count = 0;
-
-				do {
-					// check length of transparent pixels
-					for(  count = 0;  x < newzoomwidth  &&  line[x] == 0x73FE;  count++, x++  )
-						{}
-					// first runlength: transparent pixels
-					*dest++ = count;
-					uint16 has_alpha = 0;
-					// copy for non-transparent
-					count = 0;
-					while(  x < newzoomwidth  &&  line[x] != 0x73FE  ) {
-						PIXVAL pixval = line[x++];
-						if(  pixval >= 0x8020  &&  !has_alpha  ) {
-							if(  count  ) {
-								*dest++ = count;
-								dest += count;
-								count = 0;
-								*dest++ = TRANSPARENT_RUN;
-							}
-							has_alpha = TRANSPARENT_RUN;
-						}
-						else if(  pixval < 0x8020  &&  has_alpha  ) {
-							if(  count  ) {
-								*dest++ = count+TRANSPARENT_RUN;
-								dest += count;
-								count = 0;
-								*dest++ = TRANSPARENT_RUN;
-							}
-							has_alpha = 0;
-						}
-						count++;
-						dest[count] = pixval;
-					}
-
-					/*
-					 * If it is not the first clear-colored-run pair and its colored run is empty
-					 * --> it is superfluous and can be removed by rolling back the pointer
-					 */
-					if(  clear_colored_run_pair_count > 0  &&  count == 0  ) {
-						dest--;
-						// this only happens at the end of a line, so no need to increment clear_colored_run_pair_count
-					}
-					else {
-						*dest++ = count+has_alpha; // number of colored pixels
-						dest += count; // skip them
-						clear_colored_run_pair_count++;
-					}
-				} while(  x < newzoomwidth  );
-				*dest++ = 0; // mark line end
-			}
-
-			// something left?
-			images[n].w = newzoomwidth;
-			images[n].h = newzoomheight;
-			if(  newzoomheight > 0  ) {
-				const size_t zoom_len = (size_t)(((uint8 *)dest) - ((uint8 *)rezoom_baseimage[n % env_t::num_threads]));
-				images[n].len = (uint32)(zoom_len / sizeof(PIXVAL));
-				images[n].zoom_data = MALLOCN(PIXVAL, images[n].len);
-				assert( images[n].zoom_data );
-				memcpy( images[n].zoom_data, rezoom_baseimage[n % env_t::num_threads], zoom_len );
-			}
+		zoomed_img_t z;
+		if(  !prezoom_take( n, zoom_factor, z )  ) {
+			zoom_img_data( n, zoom_factor, z );
 		}
-		else {
-//			if (images[n].w <= 0) {
-//				// h=0 will be ignored, with w=0 there was an error!
-//				printf("WARNING: image%d w=0!\n", n);
-//			}
-			images[n].h = 0;
+		images[n].x = z.x;
+		images[n].y = z.y;
+		images[n].w = z.w;
+		images[n].h = z.h;
+		if(  z.data  ) {
+			images[n].len = z.len;
+			images[n].zoom_data = z.data;
 		}
+		images[n].zoom_level = zoom_factor;
+		images[n].zoom_generation = zoom_generation;
 		images[n].recode_flags &= ~FLAG_REZOOM;
 #ifdef MULTI_THREAD
 		pthread_mutex_unlock( &rezoom_img_mutex[n % env_t::num_threads] );
@@ -1835,6 +2099,8 @@ void register_image(image_t *image_in)
 	}
 
 	if(  anz_images == alloc_images  ) {
+		// the prezoom thread must not see the table moving
+		prezoom_stop();
 		if(  images==NULL  ) {
 			alloc_images = 510;
 		}
@@ -1894,6 +2160,8 @@ void register_image(image_t *image_in)
 
 	image->zoom_data = NULL;
 	image->len = image_in->len;
+	image->zoom_level = -1;
+	image->zoom_generation = 0;
 
 	image->base_x = image_in->x;
 	image->base_w = image_in->w;
@@ -1912,6 +2180,10 @@ void register_image(image_t *image_in)
 // (mostly needed when changing climate zones)
 void display_free_all_images_above( image_id above )
 {
+	prezoom_stop();
+	for(  int zl = 0;  zl <= MAX_ZOOM_FACTOR;  zl++  ) {
+		prezoom_free_level( zl );
+	}
 	while(  above < anz_images  ) {
 		anz_images--;
 		if(  images[anz_images].zoom_data != NULL  ) {
@@ -3519,6 +3791,7 @@ bool display_load_font(const char *fname, bool reload)
 
 	if(  loaded_fnt.load_from_file(fname)  ) {
 		default_font = loaded_fnt;
+		text_layout_font_generation++;
 		default_font_ascent    = default_font.get_ascent();
 		default_font_linespace = default_font.get_linespace();
 
@@ -3688,6 +3961,100 @@ void display_calc_proportional_multiline_string_len_width(int &xw, int &yh, cons
 }
 
 
+/**
+ * @returns the cached layout of @p txt up to @p len bytes or the first line break,
+ * NULL if the text is too long for the cache
+ */
+static const text_layout_t *get_text_layout(const char *txt, sint32 len  CLIP_NUM_DEF)
+{
+	uint32 hash = 2166136261u;
+	sint32 n = 0;
+	while(  n < len  &&  txt[n]  &&  txt[n] != '\n'  ) {
+		if(  n >= TEXT_LAYOUT_MAX_LEN  ) {
+			return NULL;
+		}
+		hash = (hash ^ (uint8)txt[n]) * 16777619u;
+		n++;
+	}
+
+	text_layout_t *&cache = text_layouts CLIP_NUM_INDEX;
+	if(  cache == NULL  ) {
+		cache = MALLOCN( text_layout_t, 1 << TEXT_LAYOUT_CACHE_BITS );
+		memset( cache, 0, sizeof(text_layout_t) << TEXT_LAYOUT_CACHE_BITS );
+	}
+	text_layout_t &layout = cache[ (hash ^ (hash >> TEXT_LAYOUT_CACHE_BITS)) & ((1 << TEXT_LAYOUT_CACHE_BITS) - 1) ];
+	if(  layout.font_generation == text_layout_font_generation  &&  layout.hash == hash  &&  layout.text_len == n  &&  memcmp( layout.text, txt, n ) == 0  ) {
+		return &layout;
+	}
+
+	// decode it the same way as display_text_proportional_len_clip_rgb() without cache
+	const font_t *const fnt = &default_font;
+	layout.font_generation = 0;
+	layout.glyph_count = 0;
+	layout.width = 0;
+	utf8_decoder_t decoder((utf8 const*)txt);
+	size_t iTextPos = 0;
+	while(  iTextPos < (size_t)len  &&  decoder.has_next()  ) {
+		utf32 c = decoder.next();
+		iTextPos = decoder.get_position() - (utf8 const*)txt;
+		if(  c == '\n'  ) {
+			break;
+		}
+		if(  iTextPos > (size_t)n  ) {
+			// last character is cut by len
+			return NULL;
+		}
+		if(  !fnt->is_valid_glyph(c)  ) {
+			c = 0;
+		}
+		layout.glyphs[layout.glyph_count++] = c;
+		layout.width += fnt->get_glyph_advance(c);
+	}
+	layout.hash = hash;
+	layout.text_len = n;
+	memcpy( layout.text, txt, n );
+	layout.font_generation = text_layout_font_generation;
+	return &layout;
+}
+
+
+/// draws a single glyph with its origin at x,y
+static inline void display_glyph(const font_t::glyph_t &glyph, scr_coord_val x, scr_coord_val y, const PIXVAL color, scr_coord_val cL, scr_coord_val cR, scr_coord_val cT, scr_coord_val cB)
+{
+	const uint8 *p = glyph.bitmap;
+
+	// glyph x clipping
+	const int g_left  = max(cL - x - glyph.left, 0);
+	const int g_right = min(cR - x - glyph.left, glyph.width);
+	if(  g_left >= g_right  ) {
+		return;
+	}
+
+	// all visible rows
+	const int h_top = max(cT - y - glyph.top, 0);
+	const int h_bottom = min(cB - y - glyph.top, (int)glyph.height);
+	int screen_pos = (y + glyph.top + h_top) * disp_width + x + glyph.left;
+	for (int h = h_top; h < h_bottom; h++) {
+		PIXVAL* dst = textur + screen_pos + g_left;
+
+		// all columns
+		for(int gx=g_left; gx<g_right; gx++) {
+			int alpha = p[h*glyph.width + gx];
+
+			if(alpha > 31) {
+				// opaque
+				*dst++ = color;
+			} else {
+				// partially transparent -> blend it
+				PIXVAL old_color = *dst;
+				*dst++ = colors_blend_alpha32(old_color, color, alpha);
+			}
+		}
+		screen_pos += disp_width;
+	}
+}
+
+
 /**
  * len parameter added - use -1 for previous behaviour.
  * completely renovated for unicode and 10 bit width and variable height
@@ -3715,6 +4082,10 @@ scr_coord_val display_text_proportional_len_clip_rgb(scr_coord_val x, scr_coord_
 		len = 0x7FFF;
 	}
 
+	const text_layout_t *layout = get_text_layout( txt, len  CLIP_NUM_PAR );
+	// the width for alignment includes following lines (unless there are none)
+	const bool layout_width = layout  &&  (layout->text_len >= len  ||  txt[layout->text_len] != '\n');
+
 	// adapt x-coordinate for alignment
 	switch (flags & ( ALIGN_LEFT | ALIGN_CENTER_H | ALIGN_RIGHT) ) {
 		case ALIGN_LEFT:
@@ -3722,11 +4093,11 @@ scr_coord_val display_text_proportional_len_clip_rgb(scr_coord_val x, scr_coord_
 			break;
 
 		case ALIGN_CENTER_H:
-			x -= display_calc_proportional_string_len_width(txt, len) / 2;
+			x -= (layout_width ? layout->width : display_calc_proportional_string_len_width(txt, len)) / 2;
 			break;
 
 		case ALIGN_RIGHT:
-			x -= display_calc_proportional_string_len_width(txt, len);
+			x -= layout_width ? layout->width : display_calc_proportional_string_len_width(txt, len);
 			break;
 	}
 
@@ -3741,59 +4112,36 @@ scr_coord_val display_text_proportional_len_clip_rgb(scr_coord_val x, scr_coord_
 	// store the initial x (for dirty marking)
 	const scr_coord_val x0 = x;
 
-	// big loop, draw char by char
-	utf8_decoder_t decoder((utf8 const*)txt);
-	size_t iTextPos = 0; // pointer on text position
-
-	while (iTextPos < (size_t)len  &&  decoder.has_next()) {
-		// decode char
-		utf32 c = decoder.next();
-		iTextPos = decoder.get_position() - (utf8 const*)txt;
-
-		if(  c == '\n'  ) {
-			// stop at linebreak
-			break;
-		}
-		// print unknown character?
-		else if(  !fnt->is_valid_glyph(c)  ) {
-			c = 0;
+	if(  layout  ) {
+		for(  uint16 i = 0;  i < layout->glyph_count;  i++  ) {
+			const utf32 c = layout->glyphs[i];
+			display_glyph( fnt->get_glyph(c), x, y, color, cL, cR, cT, cB );
+			x += fnt->get_glyph_advance(c);
 		}
+	}
+	else {
+		// big loop, draw char by char
+		utf8_decoder_t decoder((utf8 const*)txt);
+		size_t iTextPos = 0; // pointer on text position
 
-		// get the data from the font
-		const font_t::glyph_t& glyph = fnt->get_glyph(c);
-		const uint8 *p = glyph.bitmap;
-
-		int screen_pos = (y + glyph.top) * disp_width + x + glyph.left;
-
-		// glyph x clipping
-		int g_left  = max(cL - x - glyph.left, 0);
-		int g_right = min(cR - x - glyph.left, glyph.width);
-
-		// all visible rows
-		for (int h = 0; h < glyph.height; h++) {
-			const int line = y + glyph.top + h;
-			if(line >= cT && line < cB) {
-
-				PIXVAL* dst = textur + screen_pos + g_left;
-
-				// all columns
-				for(int gx=g_left; gx<g_right; gx++) {
-					int alpha = p[h*glyph.width + gx];
+		while (iTextPos < (size_t)len  &&  decoder.has_next()) {
+			// decode char
+			utf32 c = decoder.next();
+			iTextPos = decoder.get_position() - (utf8 const*)txt;
 
-					if(alpha > 31) {
-						// opaque
-						*dst++ = color;
-					} else {
-						// partially transparent -> blend it
-						PIXVAL old_color = *dst;
-						*dst++ = colors_blend_alpha32(old_color, color, alpha);
-					}
-				}
+			if(  c == '\n'  ) {
+				// stop at linebreak
+				break;
+			}
+			// print unknown character?
+			else if(  !fnt->is_valid_glyph(c)  ) {
+				c = 0;
 			}
-			screen_pos += disp_width;
-		}
 
-		x += fnt->get_glyph_advance(c);
+			// get the data from the font
+			display_glyph( fnt->get_glyph(c), x, y, color, cL, cR, cT, cB );
+			x += fnt->get_glyph_advance(c);
+		}
 	}
 
 	if(  dirty  ) {
@@ -4362,8 +4710,15 @@ void display_flush_buffer()
 #endif
 
 	// combine current with last dirty tiles
+	uint32 any_dirty = 0;
 	for(  int i = 0;  i < tile_buffer_length;  i++  ) {
 		tile_dirty_old[i] |= tile_dirty[i];
+		any_dirty |= tile_dirty_old[i];
+	}
+
+	if(  any_dirty == 0  ) {
+		// nothing changed, so nothing to send to the backend (tile_dirty is all zero too)
+		return;
 	}
 
 	const int tile_words_per_line = tile_buffer_per_line >> 5;
@@ -4502,6 +4857,7 @@ bool simgraph_init(scr_size window_size, sint16 full_screen)
 
 #ifdef MULTI_THREAD
 	pthread_mutex_init( &recode_img_mutex, NULL );
+	pthread_mutex_init( &prezoom_memory_mutex, NULL );
 #endif
 
 	// init rezoom_img()
@@ -4610,9 +4966,15 @@ void simgraph_exit()
 	images = NULL;
 #ifdef MULTI_THREAD
 	pthread_mutex_destroy( &recode_img_mutex );
+	pthread_mutex_destroy( &prezoom_memory_mutex );
 	for(  int i = 0;  i < MAX_THREADS;  i++  ) {
 		pthread_mutex_destroy( &rezoom_img_mutex[i] );
+		free( text_layouts[i] );
+		text_layouts[i] = NULL;
 	}
+#else
+	free( text_layouts );
+	text_layouts = NULL;
 #endif
 }
 
@@ -21,6 +21,7 @@
 #include "../ground/wasser.h"
 #include "../dataobj/environment.h"
 #include "../obj/zeiger.h"
+#include "../obj/gebaeude.h"
 #include "../utils/simrandom.h"
 
 uint16 win_get_statusbar_height(); // simwin.h
@@ -73,19 +74,11 @@ void *display_region_thread( void *ptr )
 		simthread_barrier_wait( &display_barrier_start ); // wait for all to start
 		clear_all_poly_clip( view->thread_num );
 		display_set_clip_wh( view->lt_cl.x, view->lt_cl.y, view->wh_cl.x, view->wh_cl.y, view->thread_num );
-		view->show_routine->display_region( view->lt, view->wh, view->y_min, view->y_max, false, true, view->thread_num );
+		view->show_routine->display_region( view->lt, view->wh, view->y_min, view->y_max, false, view->thread_num );
 		simthread_barrier_wait( &display_barrier_end ); // wait for all to finish
 	}
 }
 
-/* The following mutex is only needed for smart cursor */
-// mutex for changing settings on hiding buildings/trees
-static pthread_mutex_t hide_mutex = PTHREAD_MUTEX_INITIALIZER;
-static bool threads_req_pause = false;  // set true to pause all threads to display smartcursor region single threaded
-static uint8 num_threads_paused = 0; // number of threads in the paused state
-static pthread_cond_t hiding_cond = PTHREAD_COND_INITIALIZER;
-static pthread_cond_t waiting_cond = PTHREAD_COND_INITIALIZER;
-
 #if COLOUR_DEPTH != 0
 static bool can_multithreading = true;
 #endif
@@ -202,6 +195,9 @@ void main_view_t::display(bool force_dirty)
 		viewport->prepared_rect = view_rect;
 	}
 
+	// only animations in view need a redraw
+	gebaeude_t::update_animations( view_rect );
+
 #ifdef MULTI_THREAD
 	if(  can_multithreading  ) {
 		if(  !spawned_threads  ) {
@@ -241,17 +237,13 @@ void main_view_t::display(bool force_dirty)
 			lt_x += wh_x;
 		}
 
-		// init variables required to draw smart cursor
-		threads_req_pause = false;
-		num_threads_paused = 0;
-
 		// and start drawing
 		simthread_barrier_wait( &display_barrier_start );
 
 		// the last we can run ourselves, setting clip_wh to the screen edge instead of wh_x (in case disp_width % num_threads != 0)
 		clear_all_poly_clip( env_t::num_threads - 1 );
 		display_set_clip_wh( lt_x, clip_rr.y, clip_rr.w, clip_rr.h, env_t::num_threads - 1 );
-		display_region( koord( lt_x - IMG_SIZE / 2, clip_rr.y ), koord( clip_rr.x + clip_rr.w + IMG_SIZE, clip_rr.h ), y_min, dpy_height + 4 * 4, false, true, env_t::num_threads - 1 );
+		display_region( koord( lt_x - IMG_SIZE / 2, clip_rr.y ), koord( clip_rr.x + clip_rr.w + IMG_SIZE, clip_rr.h ), y_min, dpy_height + 4 * 4, false, env_t::num_threads - 1 );
 
 		simthread_barrier_wait( &display_barrier_end );
 
@@ -261,7 +253,7 @@ void main_view_t::display(bool force_dirty)
 	else {
 		// slow serial way of display
 		clear_all_poly_clip( 0 );
-		display_region( koord(clip_rr.x, clip_rr.y), koord(clip_rr.w, clip_rr.h), y_min, dpy_height + 4 * 4, false, false, 0 );
+		display_region( koord(clip_rr.x, clip_rr.y), koord(clip_rr.w, clip_rr.h), y_min, dpy_height + 4 * 4, false, 0 );
 	}
 #else
 	clear_all_poly_clip();
@@ -368,7 +360,7 @@ void main_view_t::clear_prepared() const
 
 
 #ifdef MULTI_THREAD
-void main_view_t::display_region( koord lt, koord wh, sint16 y_min, sint16 y_max, bool /*force_dirty*/, bool threaded, const sint8 clip_num )
+void main_view_t::display_region( koord lt, koord wh, sint16 y_min, sint16 y_max, bool /*force_dirty*/, const sint8 clip_num )
 #else
 void main_view_t::display_region( koord lt, koord wh, sint16 y_min, sint16 y_max, bool /*force_dirty*/ )
 #endif
@@ -506,74 +498,13 @@ void main_view_t::display_region( koord lt, koord wh, sint16 y_min, sint16 y_max
 					sint16 yypos = ypos - tile_raster_scale_y( min( gr->get_hoehe(), hmax_ground ) * TILE_HEIGHT_STEP, IMG_SIZE );
 					if(  yypos - IMG_SIZE * 3 < wh.y + lt.y  &&  yypos + IMG_SIZE > lt.y  ) {
 						const koord pos(i,j);
-						if(  env_t::hide_under_cursor  &&  needs_hiding  ) {
-							// If the corresponding setting is on, then hide trees and buildings under mouse cursor
-#ifdef MULTI_THREAD
-							if(  threaded  ) {
-								pthread_mutex_lock( &hide_mutex );
-								if(  threads_req_pause  ) {
-									// another thread is requesting we pause
-									num_threads_paused++;
-									pthread_cond_broadcast( &waiting_cond ); // signal the requesting thread that another thread has paused
-
-									// wait until no longer requested to pause
-									while(  threads_req_pause  ) {
-										pthread_cond_wait( &hiding_cond, &hide_mutex );
-									}
-
-									num_threads_paused--;
-								}
-								if(  shortest_distance( pos, cursor_pos ) <= env_t::cursor_hide_range  ) {
-									// wait until all threads are paused
-									threads_req_pause = true;
-									while(  num_threads_paused < env_t::num_threads - 1  ) {
-										pthread_cond_wait( &waiting_cond, &hide_mutex );
-									}
-
-									// proceed with drawing in the hidden area singlethreaded
-									const bool saved_hide_trees = env_t::hide_trees;
-									const uint8 saved_hide_buildings = env_t::hide_buildings;
-									env_t::hide_trees = true;
-									env_t::hide_buildings = env_t::ALL_HIDDEN_BUILDING;
-
-									plan->display_obj( xpos, yypos, IMG_SIZE, true, hmin, hmax, clip_num );
-
-									env_t::hide_trees = saved_hide_trees;
-									env_t::hide_buildings = saved_hide_buildings;
-
-									// unpause all threads
-									threads_req_pause = false;
-									pthread_cond_broadcast( &hiding_cond );
-									pthread_mutex_unlock( &hide_mutex );
-								}
-								else {
-									// not in the hidden area, draw multithreaded
-									pthread_mutex_unlock( &hide_mutex );
-									plan->display_obj( xpos, yypos, IMG_SIZE, true, hmin, hmax, clip_num );
-								}
-							}
-							else {
-#endif
-								if(  shortest_distance( pos, cursor_pos ) <= env_t::cursor_hide_range  ) {
-									const bool saved_hide_trees = env_t::hide_trees;
-									const uint8 saved_hide_buildings = env_t::hide_buildings;
-									env_t::hide_trees = true;
-									env_t::hide_buildings = env_t::ALL_HIDDEN_BUILDING;
-
-									plan->display_obj( xpos, yypos, IMG_SIZE, true, hmin, hmax  CLIP_NUM_PAR);
-
-									env_t::hide_trees = saved_hide_trees;
-									env_t::hide_buildings = saved_hide_buildings;
-								}
-								else {
-									plan->display_obj( xpos, yypos, IMG_SIZE, true, hmin, hmax  CLIP_NUM_PAR);
-								}
-#ifdef MULTI_THREAD
-							}
-#endif
+						if(  env_t::hide_under_cursor  &&  needs_hiding  &&  shortest_distance( pos, cursor_pos ) <= env_t::cursor_hide_range  ) {
+							// hide trees and buildings under mouse cursor, only for this thread
+							env_t::hiding_under_cursor = true;
+							plan->display_obj( xpos, yypos, IMG_SIZE, true, hmin, hmax  CLIP_NUM_PAR);
+							env_t::hiding_under_cursor = false;
 						}
 						else {
-							// hiding turned off, draw multithreaded
 							plan->display_obj( xpos, yypos, IMG_SIZE, true, hmin, hmax  CLIP_NUM_PAR);
 						}
 					}
@@ -581,15 +512,6 @@ void main_view_t::display_region( koord lt, koord wh, sint16 y_min, sint16 y_max
 			}
 		}
 	}
-#ifdef MULTI_THREAD
-	// show thread as paused when finished
-	if(  threaded  ) {
-		pthread_mutex_lock( &hide_mutex );
-		num_threads_paused++;
-		pthread_cond_broadcast( &waiting_cond );
-		pthread_mutex_unlock( &hide_mutex );
-	}
-#endif
 }
 
 
@@ -61,10 +61,10 @@ public:
 	 * @param y_min Minimum height of the screen (top pixel row) to start processing objects to draw.
 	 * @param y_max Maximum height of the screen (bottom pixel row) to start processing objects to draw.
 	 * @param force_dirty If set to true, will mark the whole rectangle as dirty.
-	 * @param threaded If set to true, indicates there are more threads drawing on screen, and this routine will use mutexes when needed.
+	 * @param clip_num Clipping area of the drawing thread, trees and buildings under the cursor are hidden per thread without locking.
 	 */
 #ifdef MULTI_THREAD
-	void display_region( koord lt, koord wh, sint16 y_min, const sint16 y_max, bool force_dirty, bool threaded, const sint8 clip_num );
+	void display_region( koord lt, koord wh, sint16 y_min, const sint16 y_max, bool force_dirty, const sint8 clip_num );
 #else
 	void display_region( koord lt, koord wh, sint16 y_min, const sint16 y_max, bool force_dirty );
 #endif
@@ -154,55 +154,72 @@ void freight_list_sorter_t::add_ware_heading( cbuffer_t &buf, uint64 sum, uint32
 
 void freight_list_sorter_t::sort_freight(vector_tpl<ware_t> const& warray, cbuffer_t& buf, sort_mode_t sort_mode, const slist_tpl<ware_t>* full_list, const char* what_doing, halthandle_t h)
 {
-	sortby = sort_mode;
-	if (!h.is_bound() && sort_mode == by_connection) {
-		sort_mode = by_amount;
+	freight_summary_t summary;
+	summary.build( warray, sort_mode, h );
+	summary.print( buf, full_list, what_doing );
+}
+
+
+const uint32 freight_summary_t::NO_ROW;
+
+
+void freight_summary_t::add_to_row(uint32 row, ware_t::goods_amount_t amount)
+{
+	ware_t::goods_amount_t const remaining_amount = rows[row].add_goods(amount);
+	if(  remaining_amount > 0  ) {
+		// reached goods amount limit, have to discard amount and track category totals separatly
+		if(  amount_lost.empty()  ) {
+			for(  int i = 0;  i < 256;  i++  ) { // this should be tied to a category index limit constant
+				amount_lost.append( 0 );
+			}
+		}
+		amount_lost[rows[row].get_desc()->get_catg_index()] += remaining_amount;
 	}
+}
+
 
-	// added sorting to ware's destination list
-	ware_t* wlist = MALLOCN(ware_t, warray.get_count());
+bool freight_summary_t::is_sorted_by_amount() const
+{
+	return sort_mode != freight_list_sorter_t::by_name  &&  sort_mode != freight_list_sorter_t::by_via;
+}
 
-	// store the overflow when merging wares (during via sortings), looks very broken for now
-	// only created when needed
-	uint64* categories_goods_amount_lost = NULL;
 
-	uint32 pos = 0;
-	for(ware_t const& ware : warray) {
+void freight_summary_t::build(vector_tpl<ware_t> const& packets, freight_list_sorter_t::sort_mode_t mode, halthandle_t h)
+{
+	if (!h.is_bound() && mode == freight_list_sorter_t::by_connection) {
+		mode = freight_list_sorter_t::by_amount;
+	}
+	sort_mode = mode;
+	stop = h;
+	rows.clear();
+	order.clear();
+	amount_lost.clear();
+	row_of_packet.clear();
+	row_of_packet.reserve( packets.get_count() );
+
+	for(ware_t const& ware : packets) {
 		if(  ware.get_desc() == goods_manager_t::none  ||  ware.amount == 0  ||  !ware.get_next_halt().is_bound()) {
+			row_of_packet.append( NO_ROW );
 			continue;
 		}
-		wlist[pos] = ware;
 
-		if(  sort_mode == by_via_sum  ) {
+		uint32 row = NO_ROW;
+		if(  sort_mode == freight_list_sorter_t::by_via_sum  ) {
 			// via sort mode merges packets with a common next stop
-			for(  uint32 i=0;  i<pos;  i++  ) {
-				ware_t& wi = wlist[i];
+			for(  uint32 i=0;  i<rows.get_count();  i++  ) {
+				ware_t const& wi = rows[i];
 				if(wi.get_index() == ware.get_index()) {
-					bool merge = wi.get_target_halt() == ware.get_target_halt();
-					if (!merge  &&   wi.get_via_halt() == ware.get_via_halt()) {
-						//ware.set_target_halt(halthandle_t());
-						merge = true;
-					}
-					if(merge) {
-						ware_t::goods_amount_t const remaining_amount = wi.add_goods(ware.amount);
-						if(  remaining_amount > 0  ) {
-							// reached goods amount limit, have to discard amount and track category totals separatly
-							if(  categories_goods_amount_lost == NULL  ) {
-								categories_goods_amount_lost = new uint64[256](); // this should be tied to a category index limit constant
-							}
-							categories_goods_amount_lost[wi.get_desc()->get_catg_index()]+= remaining_amount;
-						}
-						pos--; // remove after merging
+					if(  wi.get_target_halt() == ware.get_target_halt()  ||  wi.get_via_halt() == ware.get_via_halt()  ) {
+						row = i;
 						break;
 					}
 				}
 			}
 		}
-
-		if (sort_mode == by_connection) {
+		else if (sort_mode == freight_list_sorter_t::by_connection) {
 			// connection mode merges packets with all their next connections common
-			for (  uint32 i = 0; i < pos; i++) {
-				ware_t& wi = wlist[i];
+			for (  uint32 i = 0; i < rows.get_count(); i++) {
+				ware_t const& wi = rows[i];
 				if (wi.get_index() == ware.get_index()) {
 					halthandle_t w_next = ware.get_next_halt();
 					halthandle_t wi_next = wi.get_next_halt();
@@ -228,7 +245,7 @@ void freight_list_sorter_t::sort_freight(vector_tpl<ware_t> const& warray, cbuff
 					if (!merge && !has_line) {
 						// not same via halt, not same line, but maybe same convoy
 						for (convoihandle_t const& c : wi_next->registered_convoys) {
-							if (c->get_goods_catg_index().is_contained(ware.get_catg_index())  &&  w_next->registered_convoys.is_contained(c)  &&  (h.is_bound() && h->registered_convoys.is_contained(c))) {
+							if (c->get_goods_catg_index().is_contained(ware.get_catg_index())  &&  w_next->registered_convoys.is_contained(c)  &&  h->registered_convoys.is_contained(c)) {
 								merge = true;
 								break;
 							}
@@ -236,76 +253,133 @@ void freight_list_sorter_t::sort_freight(vector_tpl<ware_t> const& warray, cbuff
 					}
 					if (merge) {
 						// same entry
-						ware_t::goods_amount_t const remaining_amount = wi.add_goods(ware.amount);
-						if (remaining_amount > 0) {
-							// reached goods amount limit, have to discard amount and track category totals separatly
-							if (categories_goods_amount_lost == NULL) {
-								categories_goods_amount_lost = new uint64[256](); // this should be tied to a category index limit constant
-							}
-							categories_goods_amount_lost[wi.get_desc()->get_catg_index()] += remaining_amount;
-						}
-						pos--; // remove after merging
+						row = i;
 						break;
 					}
 				}
 			}
 		}
-
-		else if(  sort_mode == by_via_owner  ) {
+		else if(  sort_mode == freight_list_sorter_t::by_via_owner  ) {
 			// player sort mode merges packets which next stop is owned by the
 			// same player
 			player_t* owner = ware.get_next_halt()->get_owner();
-			for(  uint32 i=0;  i<pos;  i++  ) {
-				ware_t& wi = wlist[i];
+			for(  uint32 i=0;  i<rows.get_count();  i++  ) {
+				ware_t const& wi = rows[i];
 				if(  wi.get_index()==ware.get_index()  &&  wi.get_next_halt().is_bound()  &&  wi.get_next_halt()->get_owner() == owner  ) {
-					ware_t::goods_amount_t const remaining_amount = wi.add_goods(ware.amount);
-					if(  remaining_amount > 0  ) {
-						// reached goods amount limit, have to discard amount and track category totals separatly
-						if(  categories_goods_amount_lost == NULL  ) {
-							categories_goods_amount_lost = new uint64[256](); // this should be tied to a category index limit constant
-						}
-						categories_goods_amount_lost[wi.get_desc()->get_catg_index()]+= remaining_amount;
-					}
-					pos--; // remove after merging
+					row = i;
 					break;
 				}
 			}
 		}
-		pos++;
+
+		if(  row == NO_ROW  ) {
+			row_of_packet.append( rows.get_count() );
+			rows.append( ware );
+		}
+		else {
+			row_of_packet.append( row );
+			add_to_row( row, ware.amount );
+		}
 	}
 
+	order.reserve( rows.get_count() );
+	for(  uint32 i = 0;  i < rows.get_count();  i++  ) {
+		order.append( i );
+	}
+	freight_list_sorter_t::sortby = sort_mode;
+	vector_tpl<ware_t> const& r = rows;
+	std::sort( order.begin(), order.end(), [&r](uint32 a, uint32 b) { return freight_list_sorter_t::compare_ware( r[a], r[b] ); } );
+}
+
+
+bool freight_summary_t::update_amounts(vector_tpl<ware_t> const& packets)
+{
+	if(  packets.get_count() != row_of_packet.get_count()  ) {
+		return false;
+	}
+
+	for(ware_t & w : rows) {
+		w.amount = 0;
+	}
+	amount_lost.clear();
+
+	for(  uint32 i = 0;  i < packets.get_count();  i++  ) {
+		ware_t const& ware = packets[i];
+		const uint32 row = row_of_packet[i];
+		if(  row == NO_ROW  ) {
+			if(  ware.amount > 0  &&  ware.get_desc() != goods_manager_t::none  &&  ware.get_next_halt().is_bound()  ) {
+				// now needs a row
+				return false;
+			}
+			continue;
+		}
+		if(  ware.get_index() != rows[row].get_index()  ) {
+			// not the same packets any more
+			return false;
+		}
+		add_to_row( row, ware.amount );
+	}
+
+	for(ware_t const& w : rows) {
+		if(  w.amount == 0  ) {
+			// emptied rows are not shown
+			return false;
+		}
+	}
+
+	if(  is_sorted_by_amount()  ) {
+		// amounts change slowly, so the order is nearly right: insertion sort
+		freight_list_sorter_t::sortby = sort_mode;
+		for(  uint32 i = 1;  i < order.get_count();  i++  ) {
+			const uint32 n = order[i];
+			uint32 j = i;
+			while(  j > 0  &&  freight_list_sorter_t::compare_ware( rows[n], rows[order[j-1]] )  ) {
+				order[j] = order[j-1];
+				j--;
+			}
+			order[j] = n;
+		}
+	}
+	return true;
+}
+
+
+void freight_summary_t::print(cbuffer_t &buf, const slist_tpl<ware_t>* full_list, const char* what_doing) const
+{
+	freight_list_sorter_t::sortby = sort_mode;
+	halthandle_t const h = stop;
+
 	// if there, give the capacity for each freight
 	slist_tpl<ware_t>                 const  dummy;
 	slist_tpl<ware_t>                 const& list     = full_list ? *full_list : dummy;
 	slist_tpl<ware_t>::const_iterator        full_i   = list.begin();
 	slist_tpl<ware_t>::const_iterator const  full_end = list.end();
 
+	const uint32 pos = order.get_count();
+
 	// at least some capacity added?
 	if(  pos != 0  ) {
-		// sort the ware's list
-		std::sort( wlist, wlist + pos, compare_ware );
-
 		// print the ware's list to buffer
 		int last_goods_index = -1;
 		int last_ware_catg = -1;
 
 		for(  uint32 j = 0;  j < pos;  j++  ) {
-			halthandle_t const halt     = wlist[j].get_target_halt();
-			halthandle_t const via_halt = wlist[j].get_via_halt();
+			ware_t const& ware = rows[order[j]];
+			halthandle_t const halt     = ware.get_target_halt();
+			halthandle_t const via_halt = ware.get_via_halt();
 
 			const char * name = "Error in Routing";
 			if(  halt.is_bound()  ) {
 				name = halt->get_name();
 			}
 
-			ware_t const& ware = wlist[j];
 			if(  last_goods_index!=ware.get_index()  &&  last_ware_catg!=ware.get_catg()  ) {
-				uint64 sum = categories_goods_amount_lost != NULL ? categories_goods_amount_lost[ware.get_desc()->get_catg_index()] : 0;
+				uint64 sum = !amount_lost.empty() ? amount_lost[ware.get_desc()->get_catg_index()] : 0;
 				last_goods_index = ware.get_index();
 				// special freight => handle different
 				last_ware_catg = (ware.get_catg()!=0) ? ware.get_catg() : -1;
 				for(  uint32 i=j;  i<pos;  i++  ) {
-					ware_t const& sumware = wlist[i];
+					ware_t const& sumware = rows[order[i]];
 					if(  last_goods_index != sumware.get_index()  ) {
 						if(  last_ware_catg != sumware.get_catg()  ) {
 							break; // next category reached ...
@@ -316,18 +390,18 @@ void freight_list_sorter_t::sort_freight(vector_tpl<ware_t> const& warray, cbuff
 
 				if(  full_list == NULL  ) {
 					// display all goods
-					add_ware_heading( buf, sum, 0, &ware, what_doing );
+					freight_list_sorter_t::add_ware_heading( buf, sum, 0, &ware, what_doing );
 				}
 				else {
 					// display goods from a list of freights
 					while(  full_i != full_end  ) {
 						ware_t const& current = *full_i++;
 						if(  last_goods_index==current.get_index()  ||  last_ware_catg==current.get_catg()  ) {
-							add_ware_heading( buf, sum, current.amount, &current, what_doing );
+							freight_list_sorter_t::add_ware_heading( buf, sum, current.amount, &current, what_doing );
 							break;
 						}
 						else {
-							add_ware_heading( buf, 0, current.amount, &current, what_doing );
+							freight_list_sorter_t::add_ware_heading( buf, 0, current.amount, &current, what_doing );
 						}
 					}
 				}
@@ -339,7 +413,7 @@ void freight_list_sorter_t::sort_freight(vector_tpl<ware_t> const& warray, cbuff
 			buf.printf(good_description_format, ware.amount, translator::translate(desc.get_mass()), translator::translate(desc.get_name()));
 
 			// special mode: simply retrieve player name
-			if(  sortby == by_via_owner  ) {
+			if(  sort_mode == freight_list_sorter_t::by_via_owner  ) {
 				if(  via_halt.is_bound()  ) {
 					buf.append(via_halt->get_owner()->get_name());
 				}
@@ -350,7 +424,7 @@ void freight_list_sorter_t::sort_freight(vector_tpl<ware_t> const& warray, cbuff
 				continue;
 			}
 
-			if (sort_mode == by_connection) {
+			if (sort_mode == freight_list_sorter_t::by_connection) {
 				// when we are here, we have a valid halthandle in h
 				halthandle_t h_next = ware.get_next_halt();
 				uint32 linecount = 0;
@@ -383,8 +457,8 @@ void freight_list_sorter_t::sort_freight(vector_tpl<ware_t> const& warray, cbuff
 			}
 
 			// the target name is not correct for the via sort
-			const bool is_factory_going = ( sortby!=by_via_sum  &&  ware.to_factory ); // exclude merged packets
-			if(  sortby!=by_via_sum  ||  via_halt==halt  ) {
+			const bool is_factory_going = ( sort_mode!=freight_list_sorter_t::by_via_sum  &&  ware.to_factory ); // exclude merged packets
+			if(  sort_mode!=freight_list_sorter_t::by_via_sum  ||  via_halt==halt  ) {
 				if(  is_factory_going  ) {
 					const fabrik_t *const factory = fabrik_t::get_fab( ware.get_target_pos() );
 					buf.printf("%s <%i,%i>", (factory ? factory->get_name() : "Invalid Factory"), ware.get_target_pos().x, ware.get_target_pos().y);
@@ -399,7 +473,7 @@ void freight_list_sorter_t::sort_freight(vector_tpl<ware_t> const& warray, cbuff
 					buf.printf(translator::translate("via %s\n"), via_halt->get_name());
 				}
 				else {
-					if(  sortby == by_via_sum  ) {
+					if(  sort_mode == freight_list_sorter_t::by_via_sum  ) {
 						// do not show undecided transfer halts
 						buf.append(name);
 					}
@@ -413,15 +487,9 @@ void freight_list_sorter_t::sort_freight(vector_tpl<ware_t> const& warray, cbuff
 		}
 	}
 
-	if (categories_goods_amount_lost != NULL) {
-		delete[] categories_goods_amount_lost;
-	}
-
 	// still entire left?
 	for(  ; full_i != full_end; ++full_i  ) {
 		ware_t const& g = *full_i;
-		add_ware_heading(buf, 0, g.amount, &g, what_doing);
+		freight_list_sorter_t::add_ware_heading(buf, 0, g.amount, &g, what_doing);
 	}
-
-	free( wlist );
 }
@@ -11,10 +11,10 @@
 
 #include "simtypes.h"
 #include "halthandle.h"
+#include "simware.h"
+#include "tpl/vector_tpl.h"
 
 template<class T> class slist_tpl;
-template<class T> class vector_tpl;
-class ware_t;
 class cbuffer_t;
 class karte_ptr_t;
 
@@ -38,6 +38,8 @@ public:
 	static void sort_freight(vector_tpl<ware_t> const& warray, cbuffer_t& buf, sort_mode_t sort_mode, const slist_tpl<ware_t>* full_list, const char* what_doing, halthandle_t h);
 
 private:
+	friend class freight_summary_t;
+
 	static karte_ptr_t welt;
 
 	static sort_mode_t sortby;
@@ -48,4 +50,52 @@ private:
 };
 
 
+/**
+ * Merged and sorted freight list, i.e. the rows of the freight info.
+ * Remembers which row each packet was counted in, so when only the amounts of the
+ * packets changed, the rows can be updated without sorting and merging all packets again.
+ */
+class freight_summary_t
+{
+	freight_list_sorter_t::sort_mode_t sort_mode;
+	halthandle_t stop;
+
+	/// merged packets
+	vector_tpl<ware_t> rows;
+
+	/// display order of the rows
+	vector_tpl<uint32> order;
+
+	/// row of every packet given to build(), or NO_ROW if not shown
+	vector_tpl<uint32> row_of_packet;
+
+	/// amount per category which did not fit into a merged row
+	vector_tpl<uint64> amount_lost;
+
+	static const uint32 NO_ROW = 0xFFFFFFFFu;
+
+	void add_to_row(uint32 row, ware_t::goods_amount_t amount);
+
+	/// true, if amounts decide about the order
+	bool is_sorted_by_amount() const;
+
+public:
+	freight_summary_t() : sort_mode(freight_list_sorter_t::by_name) {}
+
+	/**
+	 * Merges and sorts @p packets.
+	 * @param h the stop, for which connections are shown or unbound for a convoi
+	 */
+	void build(vector_tpl<ware_t> const& packets, freight_list_sorter_t::sort_mode_t mode, halthandle_t h);
+
+	/**
+	 * Takes the amounts of @p packets, which must be the same packets in the same order as in the last build().
+	 * @return false, if the rows must be built again, because packets were added, removed or emptied
+	 */
+	bool update_amounts(vector_tpl<ware_t> const& packets);
+
+	/// appends the rows as text
+	void print(cbuffer_t &buf, const slist_tpl<ware_t>* full_list, const char* what_doing) const;
+};
+
 #endif
@@ -283,6 +283,18 @@ public:
 		objlist.check_season( season_change  &&  !snowline_change );
 	}
 
+	/**
+	 * Updates only snowline dependent images of ground and objects.
+	 * Unlike check_season_snowline() no objects are created or removed (trees do not age),
+	 * so this is safe to call from world_xy_loop.
+	 */
+	void check_snowline()
+	{
+		// since bridges may alter images of ways, this order is needed!
+		objlist.calc_image();
+		calc_image_internal( true );
+	}
+
 	/**
 	 * Updates images after change of underground mode.
 	 */
@@ -90,8 +90,7 @@ public:
 
 
 citylist_frame_t::citylist_frame_t() :
-	gui_frame_t(translator::translate("City list")),
-	scrolly(gui_scrolled_list_t::windowskin, citylist_stats_t::compare)
+	gui_frame_t(translator::translate("City list"))
 {
 	old_city_count = 0;
 	old_halt_count = 0;
@@ -206,7 +205,7 @@ void citylist_frame_t::update_label()
 void citylist_frame_t::fill_list()
 {
 	old_city_count = world()->get_cities().get_count();
-	scrolly.clear_elements();
+	scrolly.clear_entries();
 	strcpy(last_name_filter, name_filter);
 	if (filter_by_owner.pressed && filterowner.get_selection() == 0) {
 		for(stadt_t* city : world()->get_cities()) {
@@ -220,7 +219,7 @@ void citylist_frame_t::fill_list()
 				}
 			}
 			if (add) {
-				scrolly.new_component<citylist_stats_t>(city);
+				scrolly.append_entry(city);
 			}
 		}
 	}
@@ -229,14 +228,13 @@ void citylist_frame_t::fill_list()
 		for(stadt_t * city : world()->get_cities() ) {
 			if(  pl == NULL  ||  city->is_within_players_network( pl ) ) {
 				if(  last_name_filter[0] == 0  ||  utf8caseutf8(city->get_name(), last_name_filter)  ) {
-					scrolly.new_component<citylist_stats_t>(city);
+					scrolly.append_entry(city);
 				}
 			}
 		}
 	}
 	old_halt_count = haltestelle_t::get_alle_haltestellen().get_count();
-	scrolly.sort(0);
-	scrolly.set_size( scrolly.get_size());
+	scrolly.sort();
 }
 
 
@@ -244,13 +242,13 @@ bool citylist_frame_t::action_triggered( gui_action_creator_t *comp, value_t v)
 {
 	if(comp == &sortedby) {
 		citylist_stats_t::sort_mode = (citylist_stats_t::sort_mode_t)(v.i | (citylist_stats_t::sort_mode & citylist_stats_t::SORT_REVERSE));
-		scrolly.sort(0);
+		scrolly.sort();
 	}
 	else if(comp == &sorteddir) {
 		bool reverse = citylist_stats_t::sort_mode <= citylist_stats_t::SORT_MODES;
 		sorteddir.pressed = reverse;
 		citylist_stats_t::sort_mode = (citylist_stats_t::sort_mode_t)((citylist_stats_t::sort_mode & ~citylist_stats_t::SORT_REVERSE) + (reverse * citylist_stats_t::SORT_REVERSE));
-		scrolly.sort(0);
+		scrolly.sort();
 	}
 	else if(comp == &filterowner) {
 		if(  filter_by_owner.pressed ) {
@@ -44,7 +44,7 @@ private:
 	char last_name_filter[256];
 	gui_textinput_t name_filter_input;
 
-	gui_scrolled_list_t scrolly;
+	gui_scrolled_city_list_t scrolly;
 
 	gui_aligned_container_t container_year, container_month;
 	gui_chart_t chart, mchart;
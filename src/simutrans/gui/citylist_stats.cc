@@ -63,6 +63,12 @@ bool citylist_stats_t::is_valid() const
 }
 
 
+bool gui_scrolled_city_list_t::is_valid_entry(stadt_t *city) const
+{
+	return world()->get_cities().is_contained(city);
+}
+
+
 bool citylist_stats_t::infowin_event(const event_t *ev)
 {
 	bool swallowed = gui_aligned_container_t::infowin_event(ev);
@@ -91,16 +97,11 @@ bool citylist_stats_t::infowin_event(const event_t *ev)
 citylist_stats_t::sort_mode_t citylist_stats_t::sort_mode = citylist_stats_t::SORT_BY_NAME;
 uint8 citylist_stats_t::player_nr = -1;
 
-bool citylist_stats_t::compare(const gui_component_t *aa, const gui_component_t *bb)
+bool citylist_stats_t::compare(stadt_t *a, stadt_t *b)
 {
 	bool reverse = citylist_stats_t::sort_mode > citylist_stats_t::SORT_MODES;
 	int sort_mode = citylist_stats_t::sort_mode & 0x1F;
 
-	const citylist_stats_t* a = dynamic_cast<const citylist_stats_t*>(aa);
-	const citylist_stats_t* b = dynamic_cast<const citylist_stats_t*>(bb);
-	// good luck with mixed lists
-	assert(a != NULL  &&  b != NULL);
-
 	if(  reverse  ) {
 		std::swap(a,b);
 	}
@@ -110,16 +111,16 @@ bool citylist_stats_t::compare(const gui_component_t *aa, const gui_component_t
 			case SORT_BY_NAME: // default
 				break;
 			case SORT_BY_SIZE:
-				return a->city->get_einwohner() < b->city->get_einwohner();
+				return a->get_einwohner() < b->get_einwohner();
 			case SORT_BY_GROWTH:
-				return a->city->get_wachstum() < b->city->get_wachstum();
+				return a->get_wachstum() < b->get_wachstum();
 			default: break;
 		}
 		// default sorting ...
 	}
 
 	// first: try to sort by number
-	const char *atxt =a->get_text();
+	const char *atxt =a->get_name();
 	int aint = 0;
 	// isdigit produces with UTF8 assertions ...
 	if(  atxt[0]>='0'  &&  atxt[0]<='9'  ) {
@@ -128,7 +129,7 @@ bool citylist_stats_t::compare(const gui_component_t *aa, const gui_component_t
 	else if(  atxt[0]=='('  &&  atxt[1]>='0'  &&  atxt[1]<='9'  ) {
 		aint = atoi( atxt+1 );
 	}
-	const char *btxt = b->get_text();
+	const char *btxt = b->get_name();
 	int bint = 0;
 	if(  btxt[0]>='0'  &&  btxt[0]<='9'  ) {
 		bint = atoi( btxt );
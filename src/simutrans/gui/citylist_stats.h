@@ -10,6 +10,7 @@
 #include "components/gui_aligned_container.h"
 #include "components/gui_label.h"
 #include "components/gui_scrolled_list.h"
+#include "components/gui_scrolled_virtual_list.h"
 #include "../world/simcity.h"
 
 class stadt_t;
@@ -48,7 +49,22 @@ public:
 	bool infowin_event(const event_t *) OVERRIDE;
 	void set_size(scr_size size) OVERRIDE;
 
-	static bool compare(const gui_component_t *a, const gui_component_t *b );
+	static bool compare(stadt_t *a, stadt_t *b);
+};
+
+
+/**
+ * Scrolled list of citylist_stats_ts.
+ * Only the cities in view get a citylist_stats_t.
+ */
+class gui_scrolled_city_list_t : public gui_scrolled_virtual_list_t<stadt_t *>
+{
+protected:
+	gui_component_t *create_row(stadt_t *city) OVERRIDE { return new citylist_stats_t(city); }
+
+	bool compare(stadt_t *a, stadt_t *b) const OVERRIDE { return citylist_stats_t::compare(a, b); }
+
+	bool is_valid_entry(stadt_t *city) const OVERRIDE;
 };
 
 #endif
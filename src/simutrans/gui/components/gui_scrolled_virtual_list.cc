@@ -0,0 +1,91 @@
+/*
+ * This file is part of the Simutrans project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#include "gui_scrolled_virtual_list.h"
+
+#include "../gui_theme.h"
+#include "../../display/simgraph.h"
+#include "../../simcolor.h"
+
+
+void gui_virtual_scrollpane_t::row_container_t::draw(scr_coord offset)
+{
+	const scr_coord screen_pos = pos + offset;
+	for(gui_component_t* const c : components) {
+		// alternate by entry, not by row in view, or the colours would change while scrolling
+		if(  checkered  &&  row_height > 0  &&  (c->get_pos().y / row_height) & 1  ) {
+			const scr_coord c_pos = screen_pos + c->get_pos();
+			display_blend_wh_rgb( c_pos.x, c_pos.y, c->get_size().w, c->get_size().h, color_idx_to_rgb(COL_WHITE), 50 );
+		}
+		c->draw( screen_pos );
+	}
+}
+
+
+gui_virtual_scrollpane_t::gui_virtual_scrollpane_t() :
+	gui_scrollpane_t(NULL, true),
+	row_width(0)
+{
+	set_component( &rows );
+}
+
+
+void gui_virtual_scrollpane_t::get_visible_range(uint32 count, uint32 &first, uint32 &last) const
+{
+	if(  rows.row_height == 0  ) {
+		// create one row to get the height
+		first = 0;
+		last = min( count, 1 );
+		return;
+	}
+	const sint32 top = max( get_scroll_y(), 0 );
+	first = min( top / rows.row_height, count );
+	last = min( (top + size.h + rows.row_height - 1) / rows.row_height + 1, count );
+}
+
+
+void gui_virtual_scrollpane_t::place_row(gui_component_t *row, uint32 n)
+{
+	const scr_size min_size = row->get_min_size();
+	rows.row_height = max( rows.row_height, min_size.h );
+	row_width = max( row_width, min_size.w );
+
+	const scr_coord_val w = max( row_width, rows.get_size().w );
+	row->set_pos( scr_coord( 0, n * rows.row_height ) );
+	if(  row->get_size() != scr_size( w, rows.row_height )  ) {
+		row->set_size( scr_size( w, rows.row_height ) );
+	}
+}
+
+
+void gui_virtual_scrollpane_t::set_row_count(uint32 count)
+{
+	scr_coord_val client_w = size.w;
+	if(  count * rows.row_height > (uint32)size.h  ) {
+		client_w -= D_SCROLLBAR_WIDTH;
+	}
+	const scr_size new_size( max( row_width, client_w ), count * rows.row_height );
+	if(  rows.get_size() != new_size  ) {
+		rows.set_size( new_size );
+		recalc_sliders_visible( size );
+		recalc_sliders( size );
+	}
+}
+
+
+scr_size gui_virtual_scrollpane_t::get_min_size() const
+{
+	// the rows are only known after drawing, so as large as a long list
+	return scr_size( max( max_width, scroll_x.get_min_size().w ), max( max_height, scroll_y.get_min_size().h ) );
+}
+
+
+void gui_virtual_scrollpane_t::draw(scr_coord offset)
+{
+	if(  rows.get_component_count() > 0  ) {
+		display_img_stretch( gui_theme_t::windowback, scr_rect( pos + offset, get_size() ) );
+	}
+	gui_scrollpane_t::draw( offset );
+}
@@ -0,0 +1,173 @@
+/*
+ * This file is part of the Simutrans project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#ifndef GUI_COMPONENTS_GUI_SCROLLED_VIRTUAL_LIST_H
+#define GUI_COMPONENTS_GUI_SCROLLED_VIRTUAL_LIST_H
+
+
+#include <algorithm>
+
+#include "gui_container.h"
+#include "gui_scrollpane.h"
+#include "../../tpl/vector_tpl.h"
+
+
+/**
+ * Scroll pane for lists with many rows of the same height.
+ * Only the rows in view are components, placed at the position of their entry.
+ * Use gui_scrolled_virtual_list_t.
+ */
+class gui_virtual_scrollpane_t : public gui_scrollpane_t
+{
+	/// holds the rows in view, but has the size of all rows
+	class row_container_t : public gui_container_t
+	{
+	public:
+		scr_coord_val row_height;
+
+		row_container_t() : row_height(0) {}
+
+		void draw(scr_coord offset) OVERRIDE;
+	};
+
+	row_container_t rows;
+
+	/// widest row seen so far
+	scr_coord_val row_width;
+
+protected:
+	scr_coord_val get_row_height() const { return rows.row_height; }
+
+	/// range of entries in view, @p last is excluded
+	void get_visible_range(uint32 count, uint32 &first, uint32 &last) const;
+
+	void add_row(gui_component_t *row) { rows.add_component( row ); }
+	void remove_row(gui_component_t *row) { rows.remove_component( row ); }
+
+	/// moves a row to the position of entry @p n, may enlarge the row height
+	void place_row(gui_component_t *row, uint32 n);
+
+	/// sets the size of all rows for @p count entries
+	void set_row_count(uint32 count);
+
+public:
+	gui_virtual_scrollpane_t();
+
+	void set_checkered(bool c) { rows.set_checkered(c); }
+
+	void draw(scr_coord offset) OVERRIDE;
+
+	scr_size get_min_size() const OVERRIDE;
+
+	scr_size get_max_size() const OVERRIDE { return scr_size::inf; }
+};
+
+
+/**
+ * Scrollable list of many entries, like all stations of a player.
+ * The entries (handles or pointers) are sorted as array and rows are only created
+ * for the entries in view. Rows of entries still in view are kept,
+ * when the list is filled again, sorted or scrolled.
+ * The rows must update themselves when drawn.
+ */
+template<class T> class gui_scrolled_virtual_list_t : public gui_virtual_scrollpane_t
+{
+	struct row_t
+	{
+		T entry;
+		gui_component_t *comp;
+	};
+
+	/// materialized rows, ordered like the entries
+	vector_tpl<row_t> visible_rows;
+
+	/// creates and removes rows, so exactly the entries in view have one
+	void update_rows()
+	{
+		uint32 first, last;
+		get_visible_range( entries.get_count(), first, last );
+
+		vector_tpl<row_t> new_rows( last - first );
+		for(  uint32 n = first;  n < last  &&  n < entries.get_count();  ) {
+			if(  !is_valid_entry( entries[n] )  ) {
+				// removed objects must not be drawn
+				entries.remove_at( n );
+				continue;
+			}
+			row_t row;
+			row.entry = entries[n];
+			row.comp = NULL;
+			for(  uint32 i = 0;  i < visible_rows.get_count();  i++  ) {
+				if(  visible_rows[i].entry == row.entry  ) {
+					row.comp = visible_rows[i].comp;
+					visible_rows.remove_at( i );
+					break;
+				}
+			}
+			if(  row.comp == NULL  ) {
+				row.comp = create_row( row.entry );
+				add_row( row.comp );
+			}
+			place_row( row.comp, n );
+			new_rows.append( row );
+			n++;
+		}
+		clear_rows();
+		swap( visible_rows, new_rows );
+		set_row_count( entries.get_count() );
+	}
+
+	void clear_rows()
+	{
+		for(row_t const& r : visible_rows) {
+			remove_row( r.comp );
+			delete r.comp;
+		}
+		visible_rows.clear();
+	}
+
+protected:
+	/// sorted entries, may contain entries removed since the last fill
+	vector_tpl<T> entries;
+
+	virtual gui_component_t *create_row(T entry) = 0;
+
+	/// @return true if @p a is before @p b
+	virtual bool compare(T a, T b) const = 0;
+
+	/// entries becoming invalid are removed when they come into view
+	virtual bool is_valid_entry(T) const { return true; }
+
+public:
+	~gui_scrolled_virtual_list_t() { clear_rows(); }
+
+	/// rows are kept until the next redraw, so they can be reused after a refill
+	void clear_entries() { entries.clear(); }
+
+	void append_entry(T entry) { entries.append( entry ); }
+
+	uint32 get_count() const { return entries.get_count(); }
+
+	/// sorts the entries, the rows are then updated on the next redraw
+	/// only call it after filling, or while all entries are still valid
+	void sort()
+	{
+		std::sort( entries.begin(), entries.end(), [this](T a, T b) { return compare( a, b ); } );
+		set_row_count( entries.get_count() );
+	}
+
+	void draw(scr_coord offset) OVERRIDE
+	{
+		const bool unknown_height = get_row_height() == 0;
+		update_rows();
+		if(  unknown_height  &&  get_row_height() > 0  ) {
+			// now the height of a row is known
+			update_rows();
+		}
+		gui_virtual_scrollpane_t::draw( offset );
+	}
+};
+
+#endif
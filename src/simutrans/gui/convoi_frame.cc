@@ -7,6 +7,7 @@
 #include <algorithm>
 
 #include "components/gui_convoiinfo.h"
+#include "components/gui_scrolled_virtual_list.h"
 
 #include "convoi_frame.h"
 #include "convoi_filter_frame.h"
@@ -56,35 +57,17 @@ char convoi_frame_t::name_filter[256] = "";
 
 /**
  * Scrolled list of gui_convoiinfo_ts.
- * Filters (by setting visibility) and sorts.
+ * Only the convoys in view get a gui_convoiinfo_t.
  */
-class gui_scrolled_convoy_list_t : public gui_scrolled_list_t
+class gui_scrolled_convoy_list_t : public gui_scrolled_virtual_list_t<convoihandle_t>
 {
-	convoi_frame_t *main;
+protected:
+	gui_component_t *create_row(convoihandle_t cnv) OVERRIDE { return new gui_convoiinfo_t(cnv); }
 
-	static convoi_frame_t *main_static;
-public:
-	gui_scrolled_convoy_list_t(convoi_frame_t *m) :  gui_scrolled_list_t(gui_scrolled_list_t::windowskin)
-	{
-		main = m;
-		set_cmp(compare);
-	}
-
-	void sort()
-	{
-		main_static = main;
-		gui_scrolled_list_t::sort(0);
-	}
-
-	static bool compare(const gui_component_t *aa, const gui_component_t *bb)
-	{
-		const gui_convoiinfo_t *a = dynamic_cast<const gui_convoiinfo_t*>(aa);
-		const gui_convoiinfo_t *b = dynamic_cast<const gui_convoiinfo_t*>(bb);
+	bool compare(convoihandle_t a, convoihandle_t b) const OVERRIDE { return convoi_frame_t::compare_convois(a, b); }
 
-		return main_static->compare_convois(a->get_cnv(), b->get_cnv());
-	}
+	bool is_valid_entry(convoihandle_t cnv) const OVERRIDE { return cnv.is_bound(); }
 };
-convoi_frame_t* gui_scrolled_convoy_list_t::main_static;
 
 
 bool convoi_frame_t::passes_filter(convoihandle_t cnv)
@@ -171,16 +154,15 @@ void convoi_frame_t::fill_list()
 	current_wt = tabs.get_active_tab_waytype();
 
 	const bool all = owner->is_public_service();
-	scrolly->clear_elements();
+	scrolly->clear_entries();
 	for(convoihandle_t const cnv : welt->convoys()) {
 		if(  all  ||  cnv->get_owner()==owner  ) {
 			if(  passes_filter( cnv )  ) {
-				scrolly->new_component<gui_convoiinfo_t>( cnv );
+				scrolly->append_entry( cnv );
 			}
 		}
 	}
 	sort_list();
-	scrolly->set_size(scr_size(get_windowsize().w, scrolly->get_size().h));
 }
 
 
@@ -238,7 +220,7 @@ convoi_frame_t::convoi_frame_t() :
 	}
 	end_table();
 
-	scrolly = new gui_scrolled_convoy_list_t(this);
+	scrolly = new gui_scrolled_convoy_list_t();
 	scrolly->set_maximize( true );
 	scrolly->set_checkered( true );
 
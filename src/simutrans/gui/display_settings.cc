@@ -17,6 +17,7 @@
 #include "../display/simgraph.h"
 #include "../tool/simmenu.h"
 #include "../player/simplay.h"
+#include "../utils/profiler.h"
 #include "../utils/simstring.h"
 #include "../sys/simsys.h"
 
@@ -191,6 +192,11 @@ gui_settings_t::gui_settings_t()
 	simloops_value_label.buf().printf(" 999.9");
 	simloops_value_label.update();
 	add_component( &simloops_value_label, 2 );
+
+	show_profiler.init( button_t::square_state, "Show profiler" );
+	show_profiler.pressed = profiler_t::is_enabled();
+	show_profiler.add_listener( this );
+	add_component( &show_profiler, 3 );
 }
 
 void gui_settings_t::draw(scr_coord offset)
@@ -227,6 +233,9 @@ void gui_settings_t::draw(scr_coord offset)
 	simloops_value_label.buf().printf(" %d%c%d", loops/10, get_fraction_sep(), loops%10 );
 	simloops_value_label.update();
 
+	// may be also switched by the server admin
+	show_profiler.pressed = profiler_t::is_enabled();
+
 	// All components are updated, now draw them...
 	gui_aligned_container_t::draw(offset);
 }
@@ -238,6 +247,10 @@ bool gui_settings_t::action_triggered(gui_action_creator_t *comp, value_t v)
 		env_t::dpi_scale = v.i;
 		dr_set_screen_scale(v.i);
 	}
+	else if (comp == &show_profiler) {
+		profiler_t::set_enabled( !profiler_t::is_enabled() );
+		show_profiler.pressed = profiler_t::is_enabled();
+	}
 	else if (comp == &screen_scale_auto) {
 		env_t::dpi_scale = -1;
 		dr_set_screen_scale(-1);
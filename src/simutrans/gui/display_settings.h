@@ -26,6 +26,7 @@ private:
 	gui_numberinput_t screen_scale_numinp;
 	button_t icon_scale_down, icon_scale_up;
 	button_t screen_scale_auto;
+	button_t show_profiler;
 	scr_coord_val base_icon_height;
 	uint icon_zoom;
 
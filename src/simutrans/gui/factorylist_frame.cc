@@ -30,8 +30,7 @@ public:
 };
 
 factorylist_frame_t::factorylist_frame_t() :
-	gui_frame_t( translator::translate("fl_title") ),
-	scrolly(gui_scrolled_list_t::windowskin, factorylist_stats_t::compare)
+	gui_frame_t( translator::translate("fl_title") )
 {
 	scrolly.set_checkered(true);
 
@@ -91,12 +90,12 @@ bool factorylist_frame_t::action_triggered( gui_action_creator_t *comp,value_t v
 {
 	if (comp == &sortedby) {
 		factorylist_stats_t::sort_mode = v.i;
-		scrolly.sort(0);
+		scrolly.sort();
 	}
 	else if (comp == &sorteddir) {
 		factorylist_stats_t::reverse = !factorylist_stats_t::reverse;
 		sorteddir.pressed = factorylist_stats_t::reverse;
-		scrolly.sort(0);
+		scrolly.sort();
 	}
 	else if(comp == &filterowner) {
 		if(  filter_by_owner.pressed ) {
@@ -116,7 +115,7 @@ bool factorylist_frame_t::action_triggered( gui_action_creator_t *comp,value_t v
 void factorylist_frame_t::fill_list()
 {
 	old_factories_count = world()->get_fab_list().get_count(); // to avoid too many redraws ...
-	scrolly.clear_elements();
+	scrolly.clear_entries();
 	if (filter_by_owner.pressed && filterowner.get_selection() == 0) {
 		for(fabrik_t* fab : world()->get_fab_list()) {
 			bool add = (name_filter[0] == 0 || utf8caseutf8(fab->get_name(), name_filter));
@@ -129,7 +128,7 @@ void factorylist_frame_t::fill_list()
 				}
 			}
 			if (add) {
-				scrolly.new_component<factorylist_stats_t>(fab);
+				scrolly.append_entry(fab);
 			}
 		}
 	}
@@ -138,13 +137,12 @@ void factorylist_frame_t::fill_list()
 		for(fabrik_t * fab : world()->get_fab_list()) {
 			if( pl == NULL  ||  fab->is_within_players_network( pl ) ) {
 				if(  name_filter[0] == 0  ||  utf8caseutf8(fab->get_name(), name_filter)) {
-					scrolly.new_component<factorylist_stats_t>( fab );
+					scrolly.append_entry( fab );
 				}
 			}
 		}
 	}
-	scrolly.sort(0);
-	scrolly.set_size(scr_size(get_windowsize().w, scrolly.get_size().h));
+	scrolly.sort();
 }
 
 
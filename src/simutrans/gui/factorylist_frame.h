@@ -29,7 +29,7 @@ private:
 	button_t filter_by_owner;
 	gui_combobox_t filterowner;
 
-	gui_scrolled_list_t scrolly;
+	gui_scrolled_factory_list_t scrolly;
 
 	static char name_filter[256];
 	gui_textinput_t name_filter_input;
@@ -85,6 +85,12 @@ bool factorylist_stats_t::is_valid() const
 }
 
 
+bool gui_scrolled_factory_list_t::is_valid_entry(fabrik_t *fab) const
+{
+	return world()->get_fab_list().is_contained(fab);
+}
+
+
 bool factorylist_stats_t::infowin_event(const event_t * ev)
 {
 	bool swallowed = gui_aligned_container_t::infowin_event(ev);
@@ -123,14 +129,8 @@ void factorylist_stats_t::draw(scr_coord pos)
 }
 
 
-bool factorylist_stats_t::compare(const gui_component_t *aa, const gui_component_t *bb)
+bool factorylist_stats_t::compare(fabrik_t *a, fabrik_t *b)
 {
-	const factorylist_stats_t* fa = dynamic_cast<const factorylist_stats_t*>(aa);
-	const factorylist_stats_t* fb = dynamic_cast<const factorylist_stats_t*>(bb);
-	// good luck with mixed lists
-	assert(fa != NULL  &&  fb != NULL);
-	fabrik_t *a=fa->fab, *b=fb->fab;
-
 	int cmp;
 	switch (sort_mode) {
 		default:
@@ -11,6 +11,7 @@
 #include "components/gui_image.h"
 #include "components/gui_label.h"
 #include "components/gui_scrolled_list.h"
+#include "components/gui_scrolled_virtual_list.h"
 #include "../simfab.h"
 
 class fabrik_t;
@@ -57,7 +58,22 @@ public:
 	bool infowin_event(const event_t *) OVERRIDE;
 	bool is_valid() const OVERRIDE;
 
-	static bool compare(const gui_component_t *a, const gui_component_t *b );
+	static bool compare(fabrik_t *a, fabrik_t *b);
+};
+
+
+/**
+ * Scrolled list of factorylist_stats_ts.
+ * Only the factories in view get a factorylist_stats_t.
+ */
+class gui_scrolled_factory_list_t : public gui_scrolled_virtual_list_t<fabrik_t *>
+{
+protected:
+	gui_component_t *create_row(fabrik_t *fab) OVERRIDE { return new factorylist_stats_t(fab); }
+
+	bool compare(fabrik_t *a, fabrik_t *b) const OVERRIDE { return factorylist_stats_t::compare(a, b); }
+
+	bool is_valid_entry(fabrik_t *fab) const OVERRIDE;
 };
 
 
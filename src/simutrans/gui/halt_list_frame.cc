@@ -8,6 +8,7 @@
 
 #include "halt_list_frame.h"
 #include "halt_list_filter_frame.h"
+#include "components/gui_scrolled_virtual_list.h"
 
 #include "../player/simplay.h"
 #include "../simhalt.h"
@@ -26,25 +27,16 @@
 
 /**
  * Scrolled list of halt_list_stats_ts.
- * Filters (by setting visibility) and sorts.
+ * Only the stations in view get a halt_list_stats_t.
  */
-class gui_scrolled_halt_list_t : public gui_scrolled_list_t
+class gui_scrolled_halt_list_t : public gui_scrolled_virtual_list_t<halthandle_t>
 {
-public:
-	gui_scrolled_halt_list_t() :  gui_scrolled_list_t(gui_scrolled_list_t::windowskin, compare) {}
+protected:
+	gui_component_t *create_row(halthandle_t halt) OVERRIDE { return new halt_list_stats_t(halt); }
 
-	void sort()
-	{
-		gui_scrolled_list_t::sort(0);
-	}
-
-	static bool compare(const gui_component_t *aa, const gui_component_t *bb)
-	{
-		const halt_list_stats_t *a = dynamic_cast<const halt_list_stats_t*>(aa);
-		const halt_list_stats_t *b = dynamic_cast<const halt_list_stats_t*>(bb);
+	bool compare(halthandle_t a, halthandle_t b) const OVERRIDE { return halt_list_frame_t::compare_halts(a, b); }
 
-		return halt_list_frame_t::compare_halts(a->get_halt(), b->get_halt());
-	}
+	bool is_valid_entry(halthandle_t halt) const OVERRIDE { return halt.is_bound(); }
 };
 
 
@@ -293,7 +285,7 @@ void halt_list_frame_t::sort_list()
 
 	haltestelle_t::stationtyp current_type = tabs.get_active_tab_stationtype();
 
-	scrolly->clear_elements();
+	scrolly->clear_entries();
 	for(halthandle_t const halt : haltestelle_t::get_alle_haltestellen()) {
 		if (halt->get_owner() != m_player) {
 			continue;
@@ -306,12 +298,10 @@ void halt_list_frame_t::sort_list()
 			continue;
 		}
 		if(  passes_filter(*halt.get_rep())  ) {
-			scrolly->new_component<halt_list_stats_t>(halt);
+			scrolly->append_entry(halt);
 		}
 	}
 	scrolly->sort();
-	scrolly->set_size(scr_size(get_windowsize().w, scrolly->get_size().h));
-
 }
 
 
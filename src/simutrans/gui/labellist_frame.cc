@@ -20,8 +20,7 @@ static const char *sort_text[labellist::SORT_MODES] = {
 };
 
 labellist_frame_t::labellist_frame_t() :
-	gui_frame_t(translator::translate("labellist_title")),
-	scrolly(gui_scrolled_list_t::windowskin, labellist_stats_t::compare)
+	gui_frame_t(translator::translate("labellist_title"))
 {
 	set_table_layout(3,0);
 
@@ -67,7 +66,7 @@ void labellist_frame_t::fill_list()
 {
 	label_count = welt->get_label_list().get_count();
 
-	scrolly.clear_elements();
+	scrolly.clear_entries();
 	for(koord const& pos : welt->get_label_list()) {
 		label_t* label = welt->lookup_kartenboden(pos)->find<label_t>();
 		const char* name = welt->lookup_kartenboden(pos)->get_text();
@@ -75,11 +74,11 @@ void labellist_frame_t::fill_list()
 		// Check them to avoid crashes.
 		if(label  &&  name  &&  (!labellist_stats_t::filter  ||  (label  &&  (label->get_owner() == welt->get_active_player())))) {
 			if(  name_filter[0] == 0  ||  utf8caseutf8(name, name_filter)  ) {
-				scrolly.new_component<labellist_stats_t>(pos);
+				scrolly.append_entry(pos);
 			}
 		}
 	}
-	scrolly.sort(0);
+	scrolly.sort();
 	reset_min_windowsize();
 }
 
@@ -103,12 +102,12 @@ bool labellist_frame_t::action_triggered( gui_action_creator_t *comp,value_t v)
 {
 	if(comp == &sortedby) {
 		labellist_stats_t::sortby = (labellist::sort_mode_t)v.i;
-		scrolly.sort(0);
+		scrolly.sort();
 	}
 	else if(comp == &sorteddir) {
 		labellist_stats_t::sortreverse = !labellist_stats_t::sortreverse;
 		sorteddir.pressed = labellist_stats_t::sortreverse;
-		scrolly.sort(0);
+		scrolly.sort();
 	}
 	else if (comp == &name_filter_input) {
 		fill_list();
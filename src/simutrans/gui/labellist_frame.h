@@ -13,6 +13,7 @@
 #include "components/gui_combobox.h"
 #include "components/gui_scrolled_list.h"
 #include "components/gui_textinput.h"
+#include "labellist_stats.h"
 
 
 /**
@@ -25,7 +26,7 @@ private:
 	button_t sorteddir;
 	button_t filter;
 
-	gui_scrolled_list_t scrolly;
+	gui_scrolled_label_list_t scrolly;
 
 	static char name_filter[256];
 	gui_textinput_t name_filter_input;
@@ -22,11 +22,26 @@ bool labellist_stats_t::filter = false;
 
 static karte_ptr_t welt;
 
-bool labellist_stats_t::compare(const gui_component_t *aa, const gui_component_t *bb)
+static const label_t *get_label_at(koord pos)
 {
-	const labellist_stats_t* a = dynamic_cast<const labellist_stats_t*>(aa);
-	const labellist_stats_t* b = dynamic_cast<const labellist_stats_t*>(bb);
+	if (grund_t *gr = welt->lookup_kartenboden(pos)) {
+		return gr->find<label_t>();
+	}
+	return NULL;
+}
+
+
+static const char *get_text_at(koord pos)
+{
+	if (grund_t *gr = welt->lookup_kartenboden(pos)) {
+		return gr->get_text();
+	}
+	return "";
+}
+
 
+bool labellist_stats_t::compare(koord a, koord b)
+{
 	int cmp = 0;
 	switch (sortby) {
 		default: NOT_REACHED
@@ -36,16 +51,16 @@ bool labellist_stats_t::compare(const gui_component_t *aa, const gui_component_t
 			break;
 		}
 		case labellist::by_koord:
-			cmp = a->label_pos.x - b->label_pos.x;
+			cmp = a.x - b.x;
 			if(cmp==0) {
-				cmp = a->label_pos.y - b->label_pos.y;
+				cmp = a.y - b.y;
 			}
 			break;
 		case labellist::by_player:
 		{
 			if(!filter) {
-				const label_t* a_l = a->get_label();
-				const label_t* b_l = b->get_label();
+				const label_t* a_l = get_label_at(a);
+				const label_t* b_l = get_label_at(b);
 				if(a_l && b_l) {
 					cmp = a_l->get_owner_nr() - b_l->get_owner_nr();
 				}
@@ -54,8 +69,8 @@ bool labellist_stats_t::compare(const gui_component_t *aa, const gui_component_t
 		}
 	}
 	if(cmp==0) {
-		const char* a_name = a->get_text();
-		const char* b_name = b->get_text();
+		const char* a_name = get_text_at(a);
+		const char* b_name = get_text_at(b);
 
 		cmp = strcmp(a_name, b_name);
 	}
@@ -89,10 +104,7 @@ labellist_stats_t::labellist_stats_t(koord label_pos)
 
 const label_t* labellist_stats_t::get_label() const
 {
-	if (grund_t *gr = welt->lookup_kartenboden(label_pos)) {
-		return gr->find<label_t>();
-	}
-	return NULL;
+	return get_label_at(label_pos);
 }
 
 
@@ -110,10 +122,13 @@ bool labellist_stats_t::is_valid() const
 
 const char* labellist_stats_t::get_text() const
 {
-	if (grund_t *gr = welt->lookup_kartenboden(label_pos)) {
-		return gr->get_text();
-	}
-	return "";
+	return get_text_at(label_pos);
+}
+
+
+bool gui_scrolled_label_list_t::is_valid_entry(koord pos) const
+{
+	return get_label_at(pos) != NULL;
 }
 
 
@@ -10,6 +10,7 @@
 #include "components/gui_aligned_container.h"
 #include "components/gui_label.h"
 #include "components/gui_scrolled_list.h"
+#include "components/gui_scrolled_virtual_list.h"
 
 
 namespace labellist {
@@ -34,7 +35,7 @@ public:
 	static labellist::sort_mode_t sortby;
 	static bool sortreverse, filter;
 
-	static bool compare(const gui_component_t *a, const gui_component_t *b );
+	static bool compare(koord a, koord b);
 
 	labellist_stats_t(koord label_pos);
 
@@ -52,4 +53,19 @@ public:
 	const char* get_text() const OVERRIDE;
 };
 
+
+/**
+ * Scrolled list of labellist_stats_ts.
+ * Only the labels in view get a labellist_stats_t.
+ */
+class gui_scrolled_label_list_t : public gui_scrolled_virtual_list_t<koord>
+{
+protected:
+	gui_component_t *create_row(koord pos) OVERRIDE { return new labellist_stats_t(pos); }
+
+	bool compare(koord a, koord b) const OVERRIDE { return labellist_stats_t::compare(a, b); }
+
+	bool is_valid_entry(koord pos) const OVERRIDE;
+};
+
 #endif
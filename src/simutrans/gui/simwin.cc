@@ -36,6 +36,7 @@
 #include "../tpl/vector_tpl.h"
 #include "../utils/simstring.h"
 #include "../utils/cbuffer.h"
+#include "../utils/profiler.h"
 
 #include "map_frame.h"
 #include "help_frame.h"
@@ -1901,6 +1902,29 @@ uint16 win_get_statusbar_height()
 
 
 // finally updates the display
+/// shows the last profiler interval in the top left corner of the map
+static void display_profiler_overlay(scr_coord pos)
+{
+	const uint64 interval = profiler_t::get_last_interval_us();
+	const scr_coord_val w = proportional_string_width("sync_lists 00000 000.0% 000000") + D_MARGIN_LEFT + D_MARGIN_RIGHT;
+	const scr_coord_val h = (PROFILE_MAX + 1) * LINESPACE + D_MARGIN_TOP + D_MARGIN_BOTTOM;
+
+	display_blend_wh_rgb( pos.x, pos.y, w, h, color_idx_to_rgb(COL_BLACK), 75 );
+	mark_rect_dirty_wc( pos.x, pos.y, pos.x + w, pos.y + h );
+
+	pos += scr_coord( D_MARGIN_LEFT, D_MARGIN_TOP );
+	display_proportional_rgb( pos.x, pos.y, "section calls/s load max us", ALIGN_LEFT, color_idx_to_rgb(COL_WHITE), true );
+	for(  int i = 0;  i < PROFILE_MAX;  i++  ) {
+		pos.y += LINESPACE;
+		const profiler_t::section_stats_t &s = profiler_t::get_last_stats( (profile_section_t)i );
+		const uint32 load = interval ? (uint32)((s.total_us * 1000) / interval) : 0;
+		char buf[128];
+		sprintf( buf, "%s %u %u.%u%% %u", profiler_t::get_section_name( (profile_section_t)i ), s.calls, load / 10, load % 10, s.max_us );
+		display_proportional_rgb( pos.x, pos.y, buf, ALIGN_LEFT, load >= 500 ? color_idx_to_rgb(COL_RED) : color_idx_to_rgb(COL_WHITE), true );
+	}
+}
+
+
 void win_display_flush(double konto)
 {
 	const sint16 disp_width = display_get_width();
@@ -1978,6 +2002,10 @@ void win_display_flush(double konto)
 		display_all_win();
 		remove_old_win();
 
+		if(  profiler_t::is_enabled()  ) {
+			display_profiler_overlay( scr_coord( clip_rr.x + D_MARGIN_LEFT, clip_rr.y + D_MARGIN_TOP ) );
+		}
+
 		if(env_t::show_tooltips) {
 			// check if there is a tooltip to display
 			if(  tooltip_text  &&  *tooltip_text  ) {
@@ -727,6 +727,16 @@ void network_send_server(network_command_t* nwc )
 }
 
 
+// send data to one client, it is sent with the next network_process_send_queues()
+void network_send_client(network_command_t* nwc, SOCKET s)
+{
+	if(  nwc  &&  socket_list_t::has_client(s)  ) {
+		nwc->prepare_to_send();
+		socket_list_t::get_client( socket_list_t::get_client_id(s) ).send_queue_append( nwc->copy_packet() );
+	}
+}
+
+
 /**
  * send data to dest
  *
@@ -143,6 +143,12 @@ void network_send_all(network_command_t* nwc, bool exclude_us, uint8 player_nr =
 // nwc is invalid after the call
 void network_send_server(network_command_t* nwc );
 
+/**
+ * send command to one client by its send queue, so a slow client cannot block the caller.
+ * @note nwc is still valid after the call
+ */
+void network_send_client(network_command_t* nwc, SOCKET s);
+
 void network_reset_server();
 
 void network_core_shutdown();
@@ -25,6 +25,7 @@
 #include "../utils/simrandom.h"
 #include "../utils/cbuffer.h"
 #include "../utils/csv.h"
+#include "../utils/profiler.h"
 #include "../display/viewport.h"
 #include "../script/script.h" // callback for calls to tools
 
@@ -265,7 +266,7 @@ void nwc_nick_t::server_tools(karte_t *welt, uint32 client_id, uint8 what, const
 			if (client_id > 0) {
 				// send new nickname back to client
 				nwc_nick_t nwc(nick);
-				nwc.send(info.socket);
+				network_send_client(&nwc, info.socket);
 			}
 			else {
 				// human at server
@@ -278,7 +279,7 @@ void nwc_nick_t::server_tools(karte_t *welt, uint32 client_id, uint8 what, const
 			if (client_id > 0) {
 				// send old nickname back to client
 				nwc_nick_t nwc(info.nickname);
-				nwc.send(info.socket);
+				network_send_client(&nwc, info.socket);
 			}
 			else {
 				// human at server
@@ -428,7 +429,7 @@ bool nwc_chat_t::execute (karte_t* welt)
 					&&  i != client_id
 					&&  destination == dest_info.nickname.c_str()  )
 				{
-					nwchat->send( dest_info.socket );
+					network_send_client( nwchat, dest_info.socket );
 				}
 			}
 
@@ -647,7 +648,7 @@ bool nwc_auth_player_t::execute(karte_t *welt)
 				// send unlock-info to player on the client (to clear unlock_pending flag)
 				nwc_auth_player_t nwc;
 				nwc.player_unlocked = info.player_unlocked;
-				nwc.send( get_sender());
+				network_send_client( &nwc, get_sender() );
 			}
 		}
 	}
@@ -1498,6 +1499,29 @@ bool nwc_service_t::execute(karte_t *welt)
 			break;
 		}
 
+		case SRVC_PROFILE: {
+			// 0: stop, 1: start, 2: write trace of the last samples
+			cbuffer_t buf;
+			if (number == 2) {
+				if (profiler_t::write_chrome_trace(PROFILE_TRACE_FILE)) {
+					buf.printf("Trace written to %s%s\n", env_t::user_dir, PROFILE_TRACE_FILE);
+				}
+				else {
+					buf.append("No trace written, start the profiler first.\n");
+				}
+			}
+			else if (number <= 1) {
+				profiler_t::set_enabled(number == 1);
+			}
+			profiler_t::print_summary(buf);
+
+			nwc_service_t nws;
+			nws.flag = flag;
+			nws.text = strdup(buf);
+			nws.send(packet->get_sender());
+			break;
+		}
+
 		case SRVC_UNLOCK_COMPANY: {
 			if (number >= PLAYER_UNOWNED) {
 				break; // invalid number
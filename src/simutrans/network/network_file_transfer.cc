@@ -25,6 +25,9 @@
 #endif
 #include "../simversion.h"
 
+/// files are sent and received in pieces of this size, must fit into uint16
+#define FILE_CHUNK_SIZE (32768)
+
 
 /*
  * Functions required by both Simutrans and Nettool
@@ -43,12 +46,12 @@ const char *network_receive_file(const SOCKET src_sock, const char *const save_a
 #endif
 
 		// good place to show a progress bar
-		char rbuf[4096];
+		static char rbuf[FILE_CHUNK_SIZE];
 		sint32 length_read = 0;
 		if (FILE* const f = dr_fopen(save_as, "wb")) {
 			while(length_read < length) {
 				if(  timeout > 0  ) {
-					/** 10s for 4096 bytes:
+					/** 10s until anything arrives:
 					 * As long as you are not connected with less than 1200 Baud that should be fine
 					 * otherwise upgrade your acoustic coupler to 56k ...
 					 */
@@ -65,7 +68,7 @@ const char *network_receive_file(const SOCKET src_sock, const char *const save_a
 					}
 				}
 				// ok, now here should be something new to read
-				int i = recv(src_sock, rbuf, length_read + 4096 < length ? 4096 : length - length_read, 0);
+				int i = recv(src_sock, rbuf, length_read + FILE_CHUNK_SIZE < length ? FILE_CHUNK_SIZE : length - length_read, 0);
 				if (i > 0) {
 					fwrite(rbuf, 1, i, f);
 					length_read += i;
@@ -282,7 +285,7 @@ const char *network_send_file( const SOCKET dst_sock, const char *filename )
 		dbg->warning("network_send_file", "could not open file %s", filename);
 		return "Could not open file";
 	}
-	char buffer[1024];
+	static char buffer[FILE_CHUNK_SIZE];
 
 	// find out length
 	fseek(fp, 0, SEEK_END);
@@ -137,7 +137,7 @@ void baum_t::finish_rd()
 
 image_id baum_t::get_image() const
 {
-	if(  env_t::hide_trees  ) {
+	if(  env_t::get_hide_trees()  ) {
 		if(  env_t::hide_with_transparency  ) {
 			// we need the real age for transparency or real image
 			return IMG_EMPTY;
@@ -50,19 +50,35 @@ static pthread_mutex_t add_to_city_mutex = PTHREAD_MUTEX_INITIALIZER;
 #include "../dataobj/settings.h"
 #include "../dataobj/environment.h"
 #include "../dataobj/pakset_manager.h"
+#include "../dataobj/rect.h"
+#include "../dataobj/freelist.h"
+
+#include "../tpl/inthashtable_tpl.h"
 
 #include "../gui/obj_info.h"
 
 #include "gebaeude.h"
 
 
+/// size of the regions (in tiles) for looking up animated buildings in view
+#define ANIMATION_REGION_SHIFT (4)
+
+/// animated buildings by region of the map
+static inthashtable_tpl<uint32, vector_tpl<gebaeude_t *> > animated_buildings;
+
+static uint32 get_animation_region(koord pos)
+{
+	return (uint32)(pos.x >> ANIMATION_REGION_SHIFT) | ((uint32)(pos.y >> ANIMATION_REGION_SHIFT) << 16);
+}
+
+
 /**
  * Initializes all variables with safe, usable values
  */
 void gebaeude_t::init()
 {
 	tile = NULL;
-	anim_time = 0;
+	anim_offset = 0;
 	sync = false;
 	zeige_baugrube = false;
 	is_factory = false;
@@ -89,8 +105,8 @@ gebaeude_t::gebaeude_t(loadsave_t *file) : obj_t()
 		set_yoff(0);
 	}
 	if(tile  &&  tile->get_phases()>1) {
-		welt->sync_buildings.add( this );
-		sync = true;
+		anim_offset = sim_async_rand( 0xFFFF );
+		add_to_animations();
 	}
 }
 
@@ -114,6 +130,18 @@ gebaeude_t::gebaeude_t(koord3d pos, player_t *player, const building_tile_desc_t
 }
 
 
+void* gebaeude_t::operator new(size_t s)
+{
+	return freelist_t::gimme_node(s);
+}
+
+
+void gebaeude_t::operator delete(void* p, size_t s)
+{
+	freelist_t::putback_node(s, p);
+}
+
+
 /**
  * Destructor. Removes this from the list of sync objects if necessary.
  */
@@ -129,6 +157,9 @@ gebaeude_t::~gebaeude_t()
 		sync = false;
 		welt->sync_buildings.remove(this);
 	}
+	if(  tile  &&  tile->get_phases()>1  ) {
+		remove_from_animations();
+	}
 
 	assert(get_flag(obj_t::not_on_map)  ||  get_stadt() == NULL);
 
@@ -145,6 +176,12 @@ gebaeude_t::~gebaeude_t()
 
 void gebaeude_t::rotate90()
 {
+	const bool animated = tile->get_phases()>1;
+	if(  animated  ) {
+		// registered with the old position
+		remove_from_animations();
+	}
+
 	obj_t::rotate90();
 
 	// must or can rotate?
@@ -201,6 +238,10 @@ void gebaeude_t::rotate90()
 			welt->set_nosave();
 		}
 	}
+
+	if(  tile->get_phases()>1  ) {
+		add_to_animations();
+	}
 }
 
 
@@ -252,85 +293,141 @@ void gebaeude_t::set_tile( const building_tile_desc_t *new_tile, bool start_with
 	}
 
 	zeige_baugrube = !new_tile->get_desc()->no_construction_pit()  &&  start_with_construction;
-	if(sync) {
-		if(  new_tile->get_phases()<=1  &&  !zeige_baugrube  ) {
-			// need to stop animation
 #ifdef MULTI_THREAD
-			pthread_mutex_lock( &sync_mutex );
+	pthread_mutex_lock( &sync_mutex );
 #endif
-			welt->sync_buildings.remove(this);
-			sync = false;
-			anim_frame = 0;
-#ifdef MULTI_THREAD
-			pthread_mutex_unlock( &sync_mutex );
-#endif
-		}
+	if(  sync  &&  !zeige_baugrube  ) {
+		welt->sync_buildings.remove(this);
+		sync = false;
 	}
-	else if(  (new_tile->get_phases()>1  &&  (!is_factory  ||  get_fabrik()->is_currently_producing()) ) ||  zeige_baugrube  ) {
-		// needs now animation
-#ifdef MULTI_THREAD
-		pthread_mutex_lock( &sync_mutex );
-#endif
-		anim_frame = sim_async_rand( new_tile->get_phases() );
-		anim_time = 0;
+	else if(  !sync  &&  zeige_baugrube  ) {
+		// count down until the construction is finished
 		welt->sync_buildings.add(this);
 		sync = true;
+	}
 #ifdef MULTI_THREAD
-		pthread_mutex_unlock( &sync_mutex );
+	pthread_mutex_unlock( &sync_mutex );
 #endif
+
+	if(  tile  &&  tile->get_phases()>1  ) {
+		remove_from_animations();
 	}
 	tile = new_tile;
+	anim_frame = 0;
+	if(  tile->get_phases()>1  ) {
+		anim_offset = sim_async_rand( 0xFFFF );
+		anim_frame = get_anim_frame();
+		add_to_animations();
+	}
 	remove_ground = tile->has_image()  &&  !tile->get_desc()->needs_ground();
 	set_flag(obj_t::dirty);
 }
 
 
-sync_result gebaeude_t::sync_step(uint32 delta_t)
+sync_result gebaeude_t::sync_step(uint32)
 {
-	if(  zeige_baugrube  ) {
-		// still under construction?
-		if(  welt->get_ticks() - insta_zeit > 5000  ) {
-			set_flag( obj_t::dirty );
-			mark_image_dirty( get_image(), 0 );
-			zeige_baugrube = false;
-			if(  tile->get_phases() <= 1  ) {
-				sync = false;
-				return SYNC_REMOVE;
-			}
-		}
+	// still under construction?
+	if(  welt->get_ticks() - insta_zeit > 5000  ) {
+		set_flag( obj_t::dirty );
+		mark_image_dirty( get_image(), 0 );
+		zeige_baugrube = false;
+		sync = false;
+		return SYNC_REMOVE;
 	}
-	else {
-		if(  !is_factory  ||  get_fabrik()->is_currently_producing()  ) {
-			// normal animated building
-			anim_time += delta_t;
-			if(  anim_time > tile->get_desc()->get_animation_time()  ) {
-				anim_time -= tile->get_desc()->get_animation_time();
-
-				// old positions need redraw
-				if(  background_animated  ) {
-					set_flag( obj_t::dirty );
-					mark_images_dirty();
-				}
-				else {
-					// try foreground
-					image_id image = tile->get_foreground( anim_frame, season );
-					mark_image_dirty( image, 0 );
-				}
+	return SYNC_OK;
+}
+
+
+void gebaeude_t::add_to_animations()
+{
+#ifdef MULTI_THREAD
+	pthread_mutex_lock( &sync_mutex );
+#endif
+	const uint32 region = get_animation_region( get_pos().get_2d() );
+	if(  !animated_buildings.access( region )  ) {
+		animated_buildings.put( region );
+	}
+	animated_buildings.access( region )->append_unique( this );
+#ifdef MULTI_THREAD
+	pthread_mutex_unlock( &sync_mutex );
+#endif
+}
 
-				anim_frame++;
-				if(  anim_frame >= tile->get_phases()  ) {
-					anim_frame = 0;
-				}
 
-				if(  !background_animated  ) {
-					// next phase must be marked dirty too ...
-					image_id image = tile->get_foreground( anim_frame, season );
-					mark_image_dirty( image, 0 );
+void gebaeude_t::remove_from_animations()
+{
+#ifdef MULTI_THREAD
+	pthread_mutex_lock( &sync_mutex );
+#endif
+	if(  vector_tpl<gebaeude_t *> *list = animated_buildings.access( get_animation_region( get_pos().get_2d() ) )  ) {
+		list->remove( this );
+	}
+#ifdef MULTI_THREAD
+	pthread_mutex_unlock( &sync_mutex );
+#endif
+}
+
+
+void gebaeude_t::clear_animations()
+{
+	animated_buildings.clear();
+}
+
+
+void gebaeude_t::update_animations(const rect_t &view)
+{
+	const koord max_pos = view.origin + view.size - koord(1, 1);
+	for(  sint32 y = view.origin.y >> ANIMATION_REGION_SHIFT;  y <= max_pos.y >> ANIMATION_REGION_SHIFT;  y++  ) {
+		for(  sint32 x = view.origin.x >> ANIMATION_REGION_SHIFT;  x <= max_pos.x >> ANIMATION_REGION_SHIFT;  x++  ) {
+			if(  const vector_tpl<gebaeude_t *> *list = animated_buildings.access( (uint32)x | ((uint32)y << 16) )  ) {
+				for(gebaeude_t* const gb : *list) {
+					gb->update_animation();
 				}
 			}
 		}
 	}
-	return SYNC_OK;
+}
+
+
+uint8 gebaeude_t::get_anim_frame() const
+{
+	if(  tile->get_phases()<=1  ||  (is_factory  &&  !ptr.fab->is_currently_producing())  ) {
+		// idle factories keep their frame
+		return anim_frame;
+	}
+	const uint32 period = max( tile->get_desc()->get_animation_time(), 1 );
+	return (uint8)( ((welt->get_ticks() + anim_offset) / period) % tile->get_phases() );
+}
+
+
+void gebaeude_t::update_animation()
+{
+	if(  zeige_baugrube  ) {
+		return;
+	}
+	const uint8 new_frame = get_anim_frame();
+	if(  new_frame == anim_frame  ) {
+		return;
+	}
+
+	// old positions need redraw
+	if(  background_animated  ) {
+		set_flag( obj_t::dirty );
+		mark_images_dirty();
+	}
+	else {
+		// try foreground
+		image_id image = tile->get_foreground( anim_frame, season );
+		mark_image_dirty( image, 0 );
+	}
+
+	anim_frame = new_frame;
+
+	if(  !background_animated  ) {
+		// next phase must be marked dirty too ...
+		image_id image = tile->get_foreground( anim_frame, season );
+		mark_image_dirty( image, 0 );
+	}
 }
 
 
@@ -366,7 +463,7 @@ void gebaeude_t::calc_image()
 
 image_id gebaeude_t::get_image() const
 {
-	if(env_t::hide_buildings!=0  &&  tile->has_image()) {
+	if(env_t::get_hide_buildings()!=0  &&  tile->has_image()) {
 		// opaque houses
 	if (is_city_building()) {
 		if (skinverwaltung_t::construction_site->get_count() == 1) {
@@ -376,7 +473,7 @@ image_id gebaeude_t::get_image() const
 		// 6 is special building, 7-9 is res com ind (our type)
 		return skinverwaltung_t::construction_site->get_count() > 7 ? skinverwaltung_t::construction_site->get_image_id(tile->get_desc()->get_type() - building_desc_t::city_res + 7) : skinverwaltung_t::construction_site->get_image_id(0);
 	}
-	else if(  env_t::hide_buildings == env_t::ALL_HIDDEN_BUILDING  &&  tile->get_desc()->get_type() < building_desc_t::others  ) {
+	else if(  env_t::get_hide_buildings() == env_t::ALL_HIDDEN_BUILDING  &&  tile->get_desc()->get_type() < building_desc_t::others  ) {
 			// hide with transparency or tile without information
 			if(env_t::hide_with_transparency) {
 				if(tile->get_desc()->get_type() == building_desc_t::factory  &&  ptr.fab->get_desc()->get_placement() == factory_desc_t::Water) {
@@ -399,16 +496,16 @@ image_id gebaeude_t::get_image() const
 		return skinverwaltung_t::construction_site->get_image_id(0);
 	}
 	else {
-		return tile->get_background( anim_frame, 0, season );
+		return tile->get_background( get_anim_frame(), 0, season );
 	}
 }
 
 
 image_id gebaeude_t::get_outline_image() const
 {
-	if(env_t::hide_buildings!=0  &&  env_t::hide_with_transparency  &&  !zeige_baugrube) {
+	if(env_t::get_hide_buildings()!=0  &&  env_t::hide_with_transparency  &&  !zeige_baugrube) {
 		// opaque houses
-		return tile->get_background( anim_frame, 0, season );
+		return tile->get_background( get_anim_frame(), 0, season );
 	}
 	return IMG_EMPTY;
 }
@@ -419,11 +516,11 @@ FLAGGED_PIXVAL gebaeude_t::get_outline_colour() const
 {
 	uint8 colours[] = { COL_BLACK, COL_YELLOW, COL_YELLOW, COL_PURPLE, COL_RED, COL_GREEN };
 	FLAGGED_PIXVAL disp_colour = 0;
-	if(env_t::hide_buildings!=env_t::NOT_HIDE) {
+	if(env_t::get_hide_buildings()!=env_t::NOT_HIDE) {
 		if(is_city_building()) {
 			disp_colour = color_idx_to_rgb(colours[0]) | TRANSPARENT50_FLAG | OUTLINE_FLAG;
 		}
-		else if (env_t::hide_buildings == env_t::ALL_HIDDEN_BUILDING && tile->get_desc()->get_type() < building_desc_t::others) {
+		else if (env_t::get_hide_buildings() == env_t::ALL_HIDDEN_BUILDING && tile->get_desc()->get_type() < building_desc_t::others) {
 			// special building
 			disp_colour = color_idx_to_rgb(colours[tile->get_desc()->get_type()]) | TRANSPARENT50_FLAG | OUTLINE_FLAG;
 		}
@@ -439,9 +536,9 @@ void gebaeude_t::display(int xpos, int ypos  CLIP_NUM_DEF) const
 	const int raster_width = get_current_tile_raster_width();
 	ypos += tile_raster_scale_y(get_yoff(), raster_width); // if there is a slope below
 
-	if (env_t::hide_buildings != 0 && env_t::hide_with_transparency && !zeige_baugrube) {
+	if (env_t::get_hide_buildings() != 0 && env_t::hide_with_transparency && !zeige_baugrube) {
 		// transparent building
-		image_id img = tile->get_background(anim_frame, 0, season);
+		image_id img = tile->get_background(get_anim_frame(), 0, season);
 		if (img == IMG_EMPTY) {
 			return;
 		}
@@ -450,7 +547,7 @@ void gebaeude_t::display(int xpos, int ypos  CLIP_NUM_DEF) const
 		if (is_city_building()) {
 			disp_colour = color_idx_to_rgb(colours[0]) | TRANSPARENT50_FLAG | OUTLINE_FLAG;
 		}
-		else if (env_t::hide_buildings == env_t::ALL_HIDDEN_BUILDING && tile->get_desc()->get_type() < building_desc_t::others) {
+		else if (env_t::get_hide_buildings() == env_t::ALL_HIDDEN_BUILDING && tile->get_desc()->get_type() < building_desc_t::others) {
 			// special building
 			disp_colour = color_idx_to_rgb(colours[tile->get_desc()->get_type()]) | TRANSPARENT50_FLAG | OUTLINE_FLAG;
 		}
@@ -509,11 +606,11 @@ void gebaeude_t::display(int xpos, int ypos  CLIP_NUM_DEF) const
 			// this obj has another image on top (e.g. skyscraper)
 			ypos -= raster_width;
 
-			if (zeige_baugrube || env_t::hide_buildings) {
+			if (zeige_baugrube || env_t::get_hide_buildings()) {
 				// finish
 				return;
 			}
-			image = tile->get_background(anim_frame, ++j, season);
+			image = tile->get_background(get_anim_frame(), ++j, season);
 		}
 	}
 }
@@ -524,12 +621,12 @@ image_id gebaeude_t::get_front_image() const
 	if(zeige_baugrube) {
 		return IMG_EMPTY;
 	}
-	if (env_t::hide_buildings != 0   &&  (is_city_building()  ||  (env_t::hide_buildings == env_t::ALL_HIDDEN_BUILDING  &&  tile->get_desc()->get_type() < building_desc_t::others))) {
+	if (env_t::get_hide_buildings() != 0   &&  (is_city_building()  ||  (env_t::get_hide_buildings() == env_t::ALL_HIDDEN_BUILDING  &&  tile->get_desc()->get_type() < building_desc_t::others))) {
 		return IMG_EMPTY;
 	}
 	else {
 		// Show depots, station buildings etc.
-		return tile->get_foreground( anim_frame, season );
+		return tile->get_foreground( get_anim_frame(), season );
 	}
 }
 
@@ -1021,7 +1118,6 @@ void gebaeude_t::rdwr(loadsave_t *file)
 
 	if(file->is_loading()) {
 		anim_frame = 0;
-		anim_time = 0;
 		sync = false;
 
 		// rebuild tourist attraction list
@@ -1166,7 +1262,7 @@ void gebaeude_t::mark_images_dirty() const
 	image_id img;
 	if(  zeige_baugrube  ||
 			(!env_t::hide_with_transparency  &&
-				env_t::hide_buildings>(is_city_building() ? env_t::NOT_HIDE : env_t::SOME_HIDDEN_BUILDING))  ) {
+				env_t::get_hide_buildings()>(is_city_building() ? env_t::NOT_HIDE : env_t::SOME_HIDDEN_BUILDING))  ) {
 		img = skinverwaltung_t::construction_site->get_image_id(0);
 		mark_image_dirty(img, 0);
 	}
@@ -14,6 +14,7 @@ class building_tile_desc_t;
 class fabrik_t;
 class stadt_t;
 class grund_t;
+class rect_t;
 
 /**
  * Asynchronous or synchronous animations for buildings.
@@ -24,12 +25,13 @@ private:
 	const building_tile_desc_t *tile;
 
 	/**
-	 * Time control for animation progress.
+	 * Offset to the world ticks for the animation,
+	 * so neighbouring buildings do not show the same frame.
 	 */
-	uint16 anim_time;
+	uint16 anim_offset;
 
 	/**
-	 * Is this a sync animated object?
+	 * Is this object in the sync list, i.e. a construction site?
 	 */
 	uint8 sync:1;
 
@@ -49,6 +51,7 @@ private:
 
 	uint8 remove_ground:1;  // true if ground image can go
 
+	/// last frame marked dirty, or the frame shown by an idle factory
 	uint8 anim_frame;
 
 	/**
@@ -69,6 +72,16 @@ private:
 	 */
 	void init();
 
+	/// animated buildings are registered with the region of their position
+	void add_to_animations();
+	void remove_from_animations();
+
+	/// marks the old and new images dirty, when the animation frame changed
+	void update_animation();
+
+	/// frame of the animation, derived from the world ticks
+	uint8 get_anim_frame() const;
+
 protected:
 	gebaeude_t();
 
@@ -77,6 +90,9 @@ public:
 	gebaeude_t(koord3d pos,player_t *player, const building_tile_desc_t *t);
 	virtual ~gebaeude_t();
 
+	void* operator new(size_t s);
+	void  operator delete(void* p, size_t s);
+
 	void rotate90() OVERRIDE;
 
 	void add_alter(uint32 a);
@@ -135,11 +151,19 @@ public:
 	void rdwr(loadsave_t *file) OVERRIDE;
 
 	/**
-	 * Play animations of animated buildings.
 	 * Count-down to replace construction site image by regular image.
 	 */
 	sync_result sync_step(uint32 delta_t);
 
+	/**
+	 * Animations are derived from the world ticks, so they need no steps.
+	 * Only the animated buildings within @p view need to be redrawn, when their frame changes.
+	 */
+	static void update_animations(const rect_t &view);
+
+	/// forgets all animated buildings, when the world is destroyed
+	static void clear_animations();
+
 	/**
 	 * @return Den level (die Ausbaustufe) des Gebaudes
 	 */
@@ -164,7 +188,7 @@ public:
 	 */
 	void finish_rd() OVERRIDE;
 
-	// currently animated
+	// currently a construction site
 	bool is_sync() const { return sync; }
 
 	/**
@@ -32,6 +32,8 @@ static pthread_mutex_t calc_image_mutex = PTHREAD_MUTEX_INITIALIZER;
 #include "../ground/grund.h"
 #include "../builder/wegbauer.h"
 
+#include "../tpl/ptrhashtable_tpl.h"
+
 const uint32 POWER_TO_MW = 12;
 
 // use same precision as powernet
@@ -100,7 +102,7 @@ fabrik_t *leitung_t::suche_fab_4(const koord pos)
 leitung_t::leitung_t(loadsave_t *file) : obj_t()
 {
 	image = IMG_EMPTY;
-	set_net(NULL);
+	net = NULL;
 	ribi = ribi_t::none;
 	is_transformer = false;
 	rdwr(file);
@@ -110,7 +112,7 @@ leitung_t::leitung_t(loadsave_t *file) : obj_t()
 leitung_t::leitung_t(koord3d pos, player_t *player) : obj_t(pos)
 {
 	image = IMG_EMPTY;
-	set_net(NULL);
+	net = NULL;
 	set_owner( player );
 	set_desc(way_builder_t::leitung_desc);
 	is_transformer = false;
@@ -131,18 +133,8 @@ leitung_t::~leitung_t()
 		set_flag( obj_t::not_on_map );
 
 		if(neighbours>1) {
-			// only reconnect if two connections ...
-			bool first = true;
-			for(int i=0; i<4; i++) {
-				if(conn[i]!=NULL) {
-					if(!first) {
-						// replace both nets
-						powernet_t *new_net = new powernet_t();
-						conn[i]->replace(new_net);
-					}
-					first = false;
-				}
-			}
+			// only split if two connections ...
+			split_net(conn);
 		}
 
 		// recalc images
@@ -152,11 +144,9 @@ leitung_t::~leitung_t()
 			}
 		}
 
-		if(neighbours==0) {
-			delete net;
-		}
 		player_t::add_maintenance(get_owner(), -get_maintenance(), powerline_wt);
 	}
+	leitung_t::set_net(NULL);
 }
 
 
@@ -177,23 +167,102 @@ void leitung_t::rotate90()
 }
 
 
+powernet_t *leitung_t::get_net() const
+{
+	return net ? net->get_representative() : NULL;
+}
+
+
+void leitung_t::set_net(powernet_t *p)
+{
+	if(  p  ) {
+		p->add_user();
+	}
+	if(  net  ) {
+		net->remove_user();
+	}
+	net = p;
+}
+
+
 /**
- * replace networks connection
- * non-trivial to handle transformers correctly
+ * All neighbours are flooded at once, one tile of each in turn.
+ * When the search from some neighbours ends without meeting the others,
+ * it found a separated net. Hence only the smaller parts are flooded completely,
+ * the largest part keeps the old net.
  */
-void leitung_t::replace(powernet_t* new_net)
-{
-	if (get_net() != new_net) {
-		// convert myself ...
-//DBG_MESSAGE("leitung_t::replace()","My net %p by %p at (%i,%i)",new_net,current,base_pos.x,base_pos.y);
-		set_net(new_net);
+void leitung_t::split_net(leitung_t **conn)
+{
+	const uint8 FINISHED = 0xFF;
+
+	ptrhashtable_tpl<leitung_t *, uint8> reached; // index of the search + 1
+	vector_tpl<leitung_t *> found[4];
+	uint32 next[4];
+	uint8 part[4]; // searches which met each other belong to the same part
+	uint8 parts = 0;
+	for(  uint8 i=0;  i<4;  i++  ) {
+		next[i] = 0;
+		part[i] = FINISHED;
+		if(  conn[i]  ) {
+			found[i].append( conn[i] );
+			reached.put( conn[i], i+1 );
+			part[i] = i;
+			parts++;
+		}
 	}
 
-	leitung_t * conn[4];
-	if(gimme_neighbours(conn)>0) {
-		for(int i=0; i<4; i++) {
-			if(conn[i] && conn[i]->get_net()!=new_net) {
-				conn[i]->replace(new_net);
+	while(  parts > 1  ) {
+		for(  uint8 i=0;  i<4  &&  parts>1;  i++  ) {
+			if(  part[i] == FINISHED  ) {
+				continue;
+			}
+			if(  next[i] < found[i].get_count()  ) {
+				leitung_t *nb[4];
+				if(  found[i][next[i]++]->gimme_neighbours(nb) > 0  ) {
+					for(  uint8 j=0;  j<4;  j++  ) {
+						if(  nb[j]==NULL  ) {
+							continue;
+						}
+						const uint8 other = reached.get( nb[j] );
+						if(  other == 0  ) {
+							reached.put( nb[j], i+1 );
+							found[i].append( nb[j] );
+						}
+						else if(  part[other-1] != part[i]  ) {
+							// still connected => join the parts
+							const uint8 old_part = part[other-1];
+							for(  uint8 k=0;  k<4;  k++  ) {
+								if(  part[k] == old_part  ) {
+									part[k] = part[i];
+								}
+							}
+							parts--;
+						}
+					}
+				}
+				continue;
+			}
+
+			// are all searches of this part at their end?
+			bool exhausted = true;
+			for(  uint8 k=0;  k<4;  k++  ) {
+				if(  part[k] == part[i]  &&  next[k] < found[k].get_count()  ) {
+					exhausted = false;
+				}
+			}
+			if(  exhausted  ) {
+				// not connected to the other parts anymore
+				powernet_t *new_net = new powernet_t();
+				const uint8 separated = part[i];
+				for(  uint8 k=0;  k<4;  k++  ) {
+					if(  part[k] == separated  ) {
+						for(leitung_t* const lt : found[k]) {
+							lt->set_net( new_net );
+						}
+						part[k] = FINISHED;
+					}
+				}
+				parts--;
 			}
 		}
 	}
@@ -211,36 +280,27 @@ void leitung_t::verbinde()
 //DBG_MESSAGE("leitung_t::verbinde()","Searching net at (%i,%i)",get_pos().x,get_pos().x);
 	leitung_t * conn[4];
 	if(gimme_neighbours(conn)>0) {
-		for( uint8 i=0;  i<4 && new_net==NULL;  i++  ) {
-			if(conn[i]) {
-				new_net = conn[i]->get_net();
+		for(  uint8 i=0;  i<4;  i++  ) {
+			if(  conn[i]  &&  conn[i]->get_net()  ) {
+				// the nets are joined without touching their powerlines
+				new_net = new_net ? powernet_t::merge( new_net, conn[i]->get_net() ) : conn[i]->get_net();
 			}
 		}
 	}
 
 //DBG_MESSAGE("leitung_t::verbinde()","Found net %p",new_net);
 
-	// we are alone?
-	if(get_net()==NULL) {
-		if(new_net!=NULL) {
-			replace(new_net);
-		}
-		else {
-			// then we start a new net
-			set_net(new powernet_t());
-//DBG_MESSAGE("leitung_t::verbinde()","Creating new net %p",new_net);
-		}
+	if(  new_net==NULL  ) {
+		// we are alone => start a new net
+		new_net = new powernet_t();
 	}
-	else if(new_net) {
-		powernet_t *my_net = get_net();
-		for( uint8 i=0;  i<4;  i++  ) {
-			if(conn[i] && conn[i]->get_net()!=new_net) {
-				conn[i]->replace(new_net);
-			}
-		}
-		if(my_net && my_net!=new_net) {
-			delete my_net;
-		}
+
+	if(  net==NULL  ) {
+		set_net(new_net);
+	}
+	else if(  net!=new_net  ) {
+		// same net, only shorten the way to the representative
+		leitung_t::set_net(new_net);
 	}
 }
 
@@ -469,8 +529,8 @@ pumpe_t::~pumpe_t()
 		fab->remove_transformer_connected(this);
 		fab = NULL;
 	}
-	if(  net != NULL  ) {
-		net->sub_supply(power_supply);
+	if(  get_net() != NULL  ) {
+		get_net()->sub_supply(power_supply);
 	}
 }
 
@@ -659,8 +719,8 @@ senke_t::~senke_t()
 		fab->remove_transformer_connected(this);
 		fab = NULL;
 	}
-	if(  net != NULL  ) {
-		net->sub_demand(power_demand);
+	if(  get_net() != NULL  ) {
+		get_net()->sub_demand(power_demand);
 	}
 }
 
@@ -38,6 +38,7 @@ protected:
 
 	/**
 	* We are part of this network
+	* (or of the net it was merged into)
 	*/
 	powernet_t * net;
 
@@ -49,7 +50,11 @@ protected:
 	*/
 	void verbinde();
 
-	void replace(powernet_t* neu);
+	/**
+	 * Gives the parts, which are no longer connected after removing a powerline
+	 * with the neighbours @p conn, their own net.
+	 */
+	static void split_net(leitung_t **conn);
 
 	void add_ribi(ribi_t::ribi r) { ribi |= r; }
 
@@ -62,12 +67,12 @@ public:
 	// number of fractional bits for network load values
 	static const uint8 FRACTION_PRECISION;
 
-	powernet_t* get_net() const { return net; }
+	powernet_t* get_net() const;
 	/**
 	 * Changes the currently registered power net.
 	 * Can be overwritten to modify the power net on change.
 	 */
-	virtual void set_net(powernet_t* p) { net = p; }
+	virtual void set_net(powernet_t* p);
 
 	const way_desc_t * get_desc() { return desc; }
 	void set_desc(const way_desc_t *new_desc) { desc = new_desc; }
@@ -18,6 +18,7 @@
 
 #include "../ground/grund.h"
 #include "../obj/way/strasse.h"
+#include "../obj/way/schiene.h"
 
 #include "../dataobj/loadsave.h"
 #include "../dataobj/scenario.h"
@@ -117,6 +118,10 @@ roadsign_t::~roadsign_t()
 						weg->set_ribi_maske(ribi_t::none);
 					}
 					weg->clear_sign_flag();
+					if(  desc->is_signal_type()  ) {
+						// blocks between signals changed
+						schiene_t::track_version++;
+					}
 				}
 			}
 			else {
@@ -22,6 +22,7 @@
 
 const way_desc_t *schiene_t::default_schiene=NULL;
 bool schiene_t::show_reservations = false;
+uint32 schiene_t::track_version = 0;
 
 
 schiene_t::schiene_t() : weg_t()
@@ -44,6 +45,12 @@ schiene_t::schiene_t(loadsave_t *file) : weg_t()
 }
 
 
+schiene_t::~schiene_t()
+{
+	track_version++;
+}
+
+
 void schiene_t::cleanup(player_t *)
 {
 	// removes reservation
@@ -80,6 +87,9 @@ void schiene_t::info(cbuffer_t & buf) const
 bool schiene_t::reserve(convoihandle_t c, ribi_t::ribi dir  )
 {
 	if(can_reserve(c)) {
+		if(  reserved != c  ) {
+			c->count_reservation();
+		}
 		reserved = c;
 		/* for threeway and fourway switches we may need to alter graphic, if
 		 * direction is a diagonal (i.e. on the switching part)
@@ -30,6 +30,12 @@ public:
 
 	static bool show_reservations;
 
+	/**
+	 * changes when tracks are removed or signals built or removed,
+	 * i.e. whenever the blocks between signals might have changed
+	 */
+	static uint32 track_version;
+
 	/**
 	* File loading constructor.
 	*/
@@ -37,6 +43,8 @@ public:
 
 	schiene_t();
 
+	~schiene_t();
+
 	waytype_t get_waytype() const OVERRIDE {return track_wt;}
 
 	/**
@@ -30,6 +30,7 @@
 #include "../../dataobj/environment.h" // TILE_HEIGHT_STEP
 #include "../../dataobj/translator.h"
 #include "../../dataobj/loadsave.h"
+#include "../../dataobj/freelist.h"
 #include "../../descriptor/way_desc.h"
 #include "../../descriptor/roadsign_desc.h"
 
@@ -182,6 +183,18 @@ void weg_t::init()
 }
 
 
+void* weg_t::operator new(size_t s)
+{
+	return freelist_t::gimme_node(s);
+}
+
+
+void weg_t::operator delete(void* p, size_t s)
+{
+	freelist_t::putback_node(s, p);
+}
+
+
 weg_t::~weg_t()
 {
 	alle_wege.remove(this);
@@ -327,6 +340,7 @@ void weg_t::rotate90()
  */
 void weg_t::count_sign()
 {
+	const uint8 old_signal = flags & HAS_SIGNAL;
 	// Either only sign or signal please ...
 	flags &= ~(HAS_SIGN|HAS_SIGNAL|HAS_CROSSING);
 	const grund_t *gr=welt->lookup(get_pos());
@@ -348,18 +362,22 @@ void weg_t::count_sign()
 				if(  sign->get_desc()->get_wtyp() == get_desc()->get_wtyp()  ) {
 					// here is a sign ...
 					flags |= HAS_SIGN;
-					return;
+					break;
 				}
 			}
 			if(  signal_t const* const signal = obj_cast<signal_t>(obj)  ) {
 				if(  signal->get_desc()->get_wtyp() == get_desc()->get_wtyp()  ) {
 					// here is a signal ...
 					flags |= HAS_SIGNAL;
-					return;
+					break;
 				}
 			}
 		}
 	}
+	if(  (flags & HAS_SIGNAL) != old_signal  ) {
+		// blocks between signals changed
+		schiene_t::track_version++;
+	}
 }
 
 
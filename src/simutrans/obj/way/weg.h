@@ -118,6 +118,9 @@ public:
 
 	virtual ~weg_t();
 
+	void* operator new(size_t s);
+	void  operator delete(void* p, size_t s);
+
 	/**
 	 * @returns true if a crossing is needed
 	 */
@@ -12,10 +12,14 @@
 #include "../api_class.h"
 #include "../api_function.h"
 #include "../../builder/brueckenbauer.h"
+#include "../../builder/vehikelbauer.h"
 #include "../../builder/wegbauer.h"
+#include "../../dataobj/route.h"
 #include "../../descriptor/bridge_desc.h"
+#include "../../descriptor/vehicle_desc.h"
 #include "../../descriptor/way_desc.h"
 #include "../../tpl/binary_heap_tpl.h"
+#include "../../vehicle/vehicle.h"
 #include "../../world/simworld.h"
 
 using namespace script_api;
@@ -121,6 +125,88 @@ bool way_builder_is_allowed_step(way_builder_t *bob, grund_t *from, grund_t *to)
 }
 
 
+/// reads a single coordinate or an array of coordinates
+static void get_coord_list(HSQUIRRELVM vm, SQInteger index, vector_tpl<koord3d> &list)
+{
+	if (sq_gettype(vm, index) == OT_ARRAY) {
+		sq_pushnull(vm);
+		while(SQ_SUCCEEDED(sq_next(vm, index < 0 ? index-1 : index))) {
+			koord3d pos = param<koord3d>::get(vm, -1);
+			if (welt->lookup(pos)) {
+				list.append(pos);
+			}
+			sq_pop(vm, 2);
+		}
+		sq_pop(vm, 1);
+	}
+	else {
+		koord3d pos = param<koord3d>::get(vm, index);
+		if (welt->lookup(pos)) {
+			list.append(pos);
+		}
+	}
+}
+
+/// pushes the tiles as array of coord3d
+template<class T> static SQInteger push_coord_list(HSQUIRRELVM vm, const T &list)
+{
+	sq_newarray(vm, 0);
+	for(koord3d const& pos : list) {
+		param<koord3d>::push(vm, pos);
+		sq_arrayappend(vm, -2);
+	}
+	return 1;
+}
+
+SQInteger way_builder_calc_route(HSQUIRRELVM vm) // instance, start, targets
+{
+	way_builder_t *bob = param<way_builder_t*>::get(vm, 1);
+	if (bob == NULL) {
+		return sq_raise_error(vm, "Not a way planner instance"); // should not happen
+	}
+	if (bob->get_desc() == NULL) {
+		return sq_raise_error(vm, "Call set_build_types() before calc_route()");
+	}
+	vector_tpl<koord3d> start, targets;
+	get_coord_list(vm, 2, start);
+	get_coord_list(vm, 3, targets);
+	if (start.empty()  ||  targets.empty()) {
+		return push_coord_list(vm, vector_tpl<koord3d>());
+	}
+	if (bob->get_desc()->get_wtyp() == air_wt  &&  (start.get_count() > 1  ||  targets.get_count() > 1)) {
+		return sq_raise_error(vm, "Runways need exactly one start and one target");
+	}
+	bob->calc_route(start, targets);
+	return push_coord_list(vm, bob->get_route());
+}
+
+SQInteger vehicle_calc_route(HSQUIRRELVM vm) // class, player, vehicle desc, start, target
+{
+	player_t *player = get_my_player(vm);
+	if (player == NULL) {
+		player = param<player_t*>::get(vm, 2);
+	}
+	const vehicle_desc_t *desc = param<const vehicle_desc_t*>::get(vm, 3);
+	koord3d start = param<koord3d>::get(vm, 4);
+	koord3d target = param<koord3d>::get(vm, 5);
+	if (player == NULL  ||  desc == NULL) {
+		return sq_raise_error(vm, "Invalid player or vehicle");
+	}
+
+	route_t route;
+	if (welt->lookup(start)  &&  welt->lookup(target)) {
+		// only for the search, so the player does not pay for it
+		vehicle_t *test_driver = vehicle_builder_t::build(start, player, NULL, desc, false);
+		test_driver->set_flag( obj_t::not_on_map );
+		if (route.calc_route(welt, start, target, test_driver, 0, 0) == route_t::no_route) {
+			route.clear();
+		}
+		delete test_driver;
+	}
+	return push_coord_list(vm, route.get_route());
+}
+
+
 koord3d bridge_builder_find_end_pos(player_t *player, koord3d pos, my_ribi_t mribi, const bridge_desc_t *bridge, uint32 min_length)
 {
 	sint8 height;
@@ -201,6 +287,34 @@ void export_pathfinding(HSQUIRRELVM vm)
 	 * @param to to here, @p from and @p to must be adjacent.
 	 */
 	register_method(vm, way_builder_is_allowed_step, "is_allowed_step", true);
+	/**
+	 * Searches the cheapest route to build a way from one of the start tiles
+	 * to one of the target tiles. The search runs natively and does not call
+	 * @ref is_allowed_step for every tile.
+	 * Needs a way descriptor set by @ref set_build_types.
+	 * @param start start tile or array of start tiles
+	 * @param targets target tile or array of target tiles
+	 * @returns array of tiles from target to start, empty if no route was found
+	 * @typemask array(coord3d|array,coord3d|array)
+	 */
+	register_function(vm, way_builder_calc_route, "calc_route", 3, "x..");
+
+	end_class(vm);
+
+	/**
+	 * Class with helper methods for vehicle routes.
+	 */
+	create_class(vm, "route_planner_x", 0);
+	/**
+	 * Searches the route a vehicle would drive between two tiles on the existing ways.
+	 * @param pl player owning the vehicle
+	 * @param desc vehicle descriptor, defines the allowed ways
+	 * @param start start tile
+	 * @param target target tile
+	 * @returns array of tiles from start to target, empty if no route was found
+	 * @typemask array(player_x,vehicle_desc_x,coord3d,coord3d)
+	 */
+	STATIC register_function(vm, vehicle_calc_route, "calc_route", 5, ".xxxx", true);
 
 	end_class(vm);
 
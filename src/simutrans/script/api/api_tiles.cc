@@ -135,6 +135,86 @@ vector_tpl<convoihandle_t> const get_convoy_list(grund_t* gr)
 	return list;
 }
 
+/**
+ * Pushes one integer per square of the rectangle spanned by the coordinates
+ * at index 2 and 3, row by row in script coordinates.
+ * @param get_value returns the value of a ground tile
+ */
+template<class F> static SQInteger push_area(HSQUIRRELVM vm, F get_value)
+{
+	koord w0 = param<koord>::get(vm, 2);
+	koord w1 = param<koord>::get(vm, 3);
+	if (!welt->is_within_limits(w0)  ||  !welt->is_within_limits(w1)) {
+		return sq_raise_error(vm, "Coordinates out of range");
+	}
+	// iterate in script coordinates, so the array does not depend on map rotation
+	koord k0 = w0, k1 = w1;
+	coordinate_transform_t::koord_w2sq(k0);
+	coordinate_transform_t::koord_w2sq(k1);
+	const koord min_k( min(k0.x, k1.x), min(k0.y, k1.y) );
+	const koord max_k( max(k0.x, k1.x), max(k0.y, k1.y) );
+
+	sq_newarray(vm, 0);
+	for(sint16 y = min_k.y; y <= max_k.y; y++) {
+		for(sint16 x = min_k.x; x <= max_k.x; x++) {
+			koord k(x, y);
+			coordinate_transform_t::koord_sq2w(k);
+			const planquadrat_t *plan = welt->access_nocheck(k);
+			sq_pushinteger(vm, get_value(plan, plan->get_kartenboden()));
+			sq_arrayappend(vm, -2);
+		}
+	}
+	return 1;
+}
+
+static SQInteger square_get_heights(HSQUIRRELVM vm)
+{
+	return push_area(vm, [](const planquadrat_t *, const grund_t *gr) {
+		return gr->get_hoehe();
+	});
+}
+
+static SQInteger square_get_slopes(HSQUIRRELVM vm)
+{
+	return push_area(vm, [](const planquadrat_t *, const grund_t *gr) {
+		slope_t::type sl = gr->get_grund_hang();
+		coordinate_transform_t::slope_w2sq(sl);
+		return sl;
+	});
+}
+
+static SQInteger square_get_way_dirs(HSQUIRRELVM vm)
+{
+	const waytype_t wt = param<waytype_t>::get(vm, 4);
+	return push_area(vm, [wt](const planquadrat_t *, const grund_t *gr) {
+		ribi_t::ribi ribi = gr->get_weg_ribi_unmasked(wt);
+		coordinate_transform_t::ribi_w2sq(ribi);
+		return ribi;
+	});
+}
+
+static SQInteger square_get_owners(HSQUIRRELVM vm)
+{
+	return push_area(vm, [](const planquadrat_t *, const grund_t *gr) {
+		const obj_t *obj = gr->obj_bei(0);
+		return obj  &&  obj->get_owner_nr() != PLAYER_UNOWNED ? obj->get_owner_nr() : -1;
+	});
+}
+
+static SQInteger square_get_empty(HSQUIRRELVM vm)
+{
+	return push_area(vm, [](const planquadrat_t *, const grund_t *gr) {
+		return gr->ist_natur() ? 1 : 0;
+	});
+}
+
+static SQInteger square_get_halt_counts(HSQUIRRELVM vm)
+{
+	return push_area(vm, [](const planquadrat_t *plan, const grund_t *) {
+		return plan->get_haltlist_count();
+	});
+}
+
 void export_tiles(HSQUIRRELVM vm)
 {
 	/**
@@ -414,5 +494,45 @@ void export_tiles(HSQUIRRELVM vm)
 	 */
 	register_method(vm, &planquadrat_t::get_climate, "get_climate");
 
+	/** @name Functions to query rectangles.
+	 * Return one integer per ground tile of the rectangle between two corners (included).
+	 * The array is ordered row by row: the entry of (x,y) has index (y - min_y) * width + (x - min_x).
+	 * One call is much faster than querying every tile by itself.
+	 * Raise an error if a corner is outside of the map.
+	 */
+	//@{
+	/**
+	 * @returns array with the heights of the ground tiles
+	 * @typemask array<integer>(coord,coord)
+	 */
+	STATIC register_function(vm, &square_get_heights, "get_heights", 3, ".t|x|yt|x|y", true);
+	/**
+	 * @returns array with the encoded slopes of the ground tiles
+	 * @typemask array<slope>(coord,coord)
+	 */
+	STATIC register_function(vm, &square_get_slopes, "get_slopes", 3, ".t|x|yt|x|y", true);
+	/**
+	 * @param wt waytype
+	 * @returns array with the directions of the ways on the ground tiles, see tile_x::get_way_dirs
+	 * @typemask array<dir>(coord,coord,waytypes)
+	 */
+	STATIC register_function(vm, &square_get_way_dirs, "get_way_dirs", 4, ".t|x|yt|x|yi", true);
+	/**
+	 * @returns array with the player numbers owning the first object (like a way or a building) on the ground tiles, -1 if not owned
+	 * @typemask array<integer>(coord,coord)
+	 */
+	STATIC register_function(vm, &square_get_owners, "get_owners", 3, ".t|x|yt|x|y", true);
+	/**
+	 * @returns array with 1 for empty ground tiles (see tile_x::is_empty) and 0 otherwise
+	 * @typemask array<integer>(coord,coord)
+	 */
+	STATIC register_function(vm, &square_get_empty, "get_empty", 3, ".t|x|yt|x|y", true);
+	/**
+	 * @returns array with the number of stations covering the squares
+	 * @typemask array<integer>(coord,coord)
+	 */
+	STATIC register_function(vm, &square_get_halt_counts, "get_halt_counts", 3, ".t|x|yt|x|y", true);
+	//@}
+
 	end_class(vm);
 }
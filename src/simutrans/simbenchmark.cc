@@ -0,0 +1,504 @@
+/*
+ * This file is part of the Simutrans project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+#include "simbenchmark.h"
+#include "simdebug.h"
+#include "simhalt.h"
+#include "simintr.h"
+#include "simskin.h"
+#include "simversion.h"
+#include "simware.h"
+#include "builder/goods_manager.h"
+#include "dataobj/environment.h"
+#include "dataobj/freelist.h"
+#include "descriptor/ground_desc.h"
+#include "descriptor/skin_desc.h"
+#include "display/simgraph.h"
+#include "display/simview.h"
+#include "ground/grund.h"
+#include "gui/convoi_frame.h"
+#include "gui/factorylist_frame.h"
+#include "gui/halt_list_frame.h"
+#include "gui/simwin.h"
+#include "obj/way/weg.h"
+#include "sys/simsys.h"
+#include "tpl/vector_tpl.h"
+#include "utils/cbuffer.h"
+#include "world/simcity.h"
+#include "world/simplan.h"
+#include "world/simworld.h"
+
+
+/// temporary file of the save scenario (relative to the user directory)
+#define BENCHMARK_SAVE "benchmark-tmp.sve"
+
+
+/// keeps the compiler from removing the map scans
+static sint32 checksum = 0;
+
+/// own random generator, so every run picks the same routes and tiles
+static uint32 bench_seed = 1;
+
+static uint32 bench_rand(uint32 max)
+{
+	bench_seed ^= bench_seed << 13;
+	bench_seed ^= bench_seed >> 17;
+	bench_seed ^= bench_seed << 5;
+	return max ? bench_seed % max : 0;
+}
+
+
+static uint64 get_time_us()
+{
+	return (uint64)std::chrono::duration_cast<std::chrono::microseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+
+// rendering
+
+static void bench_draw_img(karte_t *, main_view_t *, uint32 ops)
+{
+	const image_id img = ground_desc_t::outside->get_image(0,0);
+	for(  uint32 i = 0;  i < ops;  i++  ) {
+		display_img_aux( img, 50, 50, 1, 0, true  CLIP_NUM_DEFAULT );
+	}
+}
+
+
+static bool has_color_options(karte_t *)
+{
+	return skinverwaltung_t::color_options != NULL;
+}
+
+
+static void bench_draw_color_img(karte_t *, main_view_t *, uint32 ops)
+{
+	const image_id player_img = skinverwaltung_t::color_options->get_image_id(0);
+	for(  uint32 i = 0;  i < ops;  i++  ) {
+		display_color_img( player_img, 120, 100, i%15, 0, 1 );
+	}
+}
+
+
+static void bench_draw_text(karte_t *, main_view_t *, uint32 ops)
+{
+	for(  uint32 i = 0;  i < ops;  i++  ) {
+		display_text_proportional_len_clip_rgb( 100, 120, "Dies ist ein kurzer Textetxt ...", 0, 0, false, -1 );
+	}
+}
+
+
+static void bench_draw_fillbox(karte_t *, main_view_t *, uint32 ops)
+{
+	for(  uint32 i = 0;  i < ops;  i++  ) {
+		display_fillbox_wh_rgb( 100, 120, 300, 50, 0, false );
+	}
+}
+
+
+static void bench_view(karte_t *, main_view_t *view, uint32 ops)
+{
+	for(  uint32 i = 0;  i < ops;  i++  ) {
+		view->display( true );
+	}
+}
+
+
+static void bench_frame(karte_t *, main_view_t *view, uint32 ops)
+{
+	for(  uint32 i = 0;  i < ops;  i++  ) {
+		view->display( true );
+		win_display_flush( 0.0 );
+	}
+}
+
+
+/// number of list windows for the list_windows scenario
+#define BENCHMARK_LIST_WINDOWS (20)
+
+static void open_list_windows(karte_t *)
+{
+	for(  int i = 0;  i < BENCHMARK_LIST_WINDOWS;  i++  ) {
+		gui_frame_t *win;
+		switch(  i % 3  ) {
+			case 0:  win = new halt_list_frame_t(); break;
+			case 1:  win = new convoi_frame_t(); break;
+			default: win = new factorylist_frame_t(); break;
+		}
+		win->set_windowsize( scr_size( display_get_width() / 2, display_get_height() - 40 ) );
+		create_win( scr_coord( (i * 23) % (display_get_width() / 2 + 1), 20 ), win, w_info, magic_none );
+	}
+}
+
+
+static void close_list_windows(karte_t *)
+{
+	destroy_all_win( false );
+}
+
+
+// simulation
+
+static void bench_sync_step(karte_t *welt, main_view_t *, uint32 ops)
+{
+	for(  uint32 i = 0;  i < ops;  i++  ) {
+		welt->sync_step( 200 );
+	}
+}
+
+
+static void bench_step(karte_t *welt, main_view_t *, uint32 ops)
+{
+	for(  uint32 i = 0;  i < ops;  i++  ) {
+		welt->step();
+	}
+}
+
+
+static bool has_halts(karte_t *)
+{
+	return haltestelle_t::get_alle_haltestellen().get_count() >= 2;
+}
+
+
+static void bench_routing(karte_t *welt, main_view_t *, uint32 ops)
+{
+	const vector_tpl<halthandle_t> &halts = haltestelle_t::get_alle_haltestellen();
+	const bool no_overcrowd = welt->get_settings().is_no_routing_over_overcrowding();
+	for(  uint32 i = 0;  i < ops;  i++  ) {
+		const halthandle_t start = halts[ bench_rand(halts.get_count()) ];
+		const halthandle_t target = halts[ bench_rand(halts.get_count()) ];
+		ware_t pax( goods_manager_t::passengers );
+		pax.set_target_pos( target->get_basis_pos() );
+		pax.amount = 1;
+		checksum += haltestelle_t::search_route( &start, 1, no_overcrowd, pax );
+	}
+}
+
+
+static bool has_cities(karte_t *welt)
+{
+	return !welt->get_cities().empty();
+}
+
+
+static void bench_find_destination(karte_t *welt, main_view_t *, uint32 ops)
+{
+	stadt_t::pax_return_type will_return;
+	stadt_t::factory_entry_t *factory_entry;
+	stadt_t *dest_city;
+	for(stadt_t *const city : welt->get_cities()) {
+		for(  uint32 i = 0;  i < ops;  i++  ) {
+			checksum += city->find_destination( city->access_target_factories_for_pax(), 0, &will_return, factory_entry, dest_city ).x;
+		}
+	}
+}
+
+
+static void bench_new_month(karte_t *welt, main_view_t *, uint32 ops)
+{
+	for(  uint32 i = 0;  i < ops;  i++  ) {
+		benchmark_t::new_month( welt );
+	}
+}
+
+
+// map storage, compare builds with different PLAN_BLOCK_BITS
+
+static void bench_map_scan(karte_t *welt, main_view_t *, uint32 ops)
+{
+	const koord size = welt->get_size();
+	for(  uint32 i = 0;  i < ops;  i++  ) {
+		for(  sint16 y = 0;  y < size.y;  y++  ) {
+			for(  sint16 x = 0;  x < size.x;  x++  ) {
+				checksum += welt->lookup_kartenboden_nocheck(x, y)->get_hoehe();
+			}
+		}
+	}
+}
+
+
+static void bench_map_neighbours(karte_t *welt, main_view_t *, uint32 ops)
+{
+	const koord size = welt->get_size();
+	for(  uint32 i = 0;  i < ops;  i++  ) {
+		for(  sint16 y = 1;  y < size.y-1;  y++  ) {
+			for(  sint16 x = 1;  x < size.x-1;  x++  ) {
+				for(  int n = 0;  n < 8;  n++  ) {
+					checksum += welt->access_nocheck( koord(x, y) + koord::neighbours[n] )->get_boden_count();
+				}
+			}
+		}
+	}
+}
+
+
+static void bench_map_random(karte_t *welt, main_view_t *, uint32 ops)
+{
+	const koord size = welt->get_size();
+	for(  uint32 i = 0;  i < ops;  i++  ) {
+		checksum += welt->lookup_kartenboden_nocheck( bench_rand(size.x), bench_rand(size.y) )->get_hoehe();
+	}
+}
+
+
+static bool has_ways(karte_t *)
+{
+	return !weg_t::get_alle_wege().empty();
+}
+
+
+static void bench_get_neighbour(karte_t *welt, main_view_t *, uint32 ops)
+{
+	for(  uint32 i = 0;  i < ops;  i++  ) {
+		for(weg_t *const w : weg_t::get_alle_wege()) {
+			grund_t *to;
+			checksum += welt->lookup( w->get_pos() )->get_neighbour( to, invalid_wt, ribi_t::north );
+		}
+	}
+}
+
+
+// io
+
+static void bench_save(karte_t *welt, main_view_t *, uint32 ops)
+{
+	for(  uint32 i = 0;  i < ops;  i++  ) {
+		welt->save( BENCHMARK_SAVE, false, SAVEGAME_VER_NR, true );
+	}
+}
+
+
+static const char *load_filename = NULL;
+
+static void bench_load(karte_t *welt, main_view_t *, uint32 ops)
+{
+	for(  uint32 i = 0;  i < ops;  i++  ) {
+		welt->load( load_filename );
+	}
+}
+
+
+struct scenario_t
+{
+	const char *name;
+	const char *group;
+	uint32 samples;
+	uint32 ops;     ///< operations per sample
+	void (*run)(karte_t *welt, main_view_t *view, uint32 ops);
+	bool (*available)(karte_t *welt); ///< NULL if always possible
+	void (*setup)(karte_t *welt);     ///< NULL if not needed
+	void (*cleanup)(karte_t *welt);   ///< NULL if not needed
+};
+
+// load must be last, since it replaces the world
+static const scenario_t scenarios[] = {
+	{ "draw_img",         "render", 50,  100000, bench_draw_img,         NULL, NULL, NULL },
+	{ "draw_color_img",   "render", 50,  20000,  bench_draw_color_img,   has_color_options, NULL, NULL },
+	{ "draw_text",        "render", 50,  10000,  bench_draw_text,        NULL, NULL, NULL },
+	{ "draw_fillbox",     "render", 50,  10000,  bench_draw_fillbox,     NULL, NULL, NULL },
+	{ "view",             "render", 200, 1,      bench_view,             NULL, NULL, NULL },
+	{ "frame",            "render", 200, 1,      bench_frame,            NULL, NULL, NULL },
+	{ "list_windows",     "render", 100, 1,      bench_frame,            NULL, open_list_windows, close_list_windows },
+	{ "map_scan",         "map",    20,  1,      bench_map_scan,         NULL, NULL, NULL },
+	{ "map_neighbours",   "map",    10,  1,      bench_map_neighbours,   NULL, NULL, NULL },
+	{ "map_random",       "map",    20,  1000000, bench_map_random,      NULL, NULL, NULL },
+	{ "get_neighbour",    "map",    20,  1,      bench_get_neighbour,    has_ways, NULL, NULL },
+	{ "find_destination", "sim",    20,  10000,  bench_find_destination, has_cities, NULL, NULL },
+	{ "routing",          "sim",    50,  1000,   bench_routing,          has_halts, NULL, NULL },
+	{ "sync_step",        "sim",    500, 1,      bench_sync_step,        NULL, NULL, NULL },
+	{ "step",             "sim",    200, 1,      bench_step,             NULL, NULL, NULL },
+	{ "new_month",        "sim",    5,   1,      bench_new_month,        NULL, NULL, NULL },
+	{ "save",             "io",     5,   1,      bench_save,             NULL, NULL, NULL },
+	{ "load",             "io",     3,   1,      bench_load,             NULL, NULL, NULL }
+};
+
+
+/// nearest rank percentile of a sorted list
+static uint64 percentile(const vector_tpl<uint64> &sorted, uint32 percent)
+{
+	uint32 rank = (sorted.get_count() * percent + 99) / 100;
+	if(  rank == 0  ) {
+		rank = 1;
+	}
+	return sorted[rank - 1];
+}
+
+
+static void append_json_string(cbuffer_t &buf, const char *s)
+{
+	buf.append( "\"" );
+	for(  ;  *s;  s++  ) {
+		if(  *s == '"'  ||  *s == '\\'  ) {
+			buf.append( "\\" );
+		}
+		buf.append( s, 1 );
+	}
+	buf.append( "\"" );
+}
+
+
+struct baseline_entry_t
+{
+	std::string name;
+	uint64 median_us;
+};
+
+/// reads name and median of each scenario line of an older result file
+static void read_baseline(const char *filename, vector_tpl<baseline_entry_t> &entries)
+{
+	FILE *f = dr_fopen( filename, "r" );
+	if(  f == NULL  ) {
+		dbg->warning( "benchmark_t::run()", "Cannot read baseline '%s'", filename );
+		return;
+	}
+	char line[1024];
+	while(  fgets( line, sizeof(line), f )  ) {
+		const char *name = strstr( line, "\"name\":\"" );
+		const char *median = strstr( line, "\"median_us\":" );
+		if(  name  &&  median  ) {
+			name += 8;
+			const char *end = strchr( name, '"' );
+			if(  end  ) {
+				baseline_entry_t e;
+				e.name.assign( name, end - name );
+				e.median_us = strtoull( median + 12, NULL, 10 );
+				entries.append( e );
+			}
+		}
+	}
+	fclose( f );
+}
+
+
+static bool is_selected(const scenario_t &s, const char *suite)
+{
+	return strcmp( suite, "all" ) == 0  ||  strcmp( suite, s.group ) == 0  ||  strcmp( suite, s.name ) == 0;
+}
+
+
+void benchmark_t::new_month(karte_t *welt)
+{
+	welt->new_month();
+}
+
+
+int benchmark_t::run(karte_t *welt, main_view_t *view, const char *suite, const char *savegame, const char *baseline)
+{
+	intr_set_view( view );
+	welt->set_fast_forward( true );
+	intr_disable();
+
+	vector_tpl<baseline_entry_t> baseline_entries;
+	if(  baseline  ) {
+		read_baseline( baseline, baseline_entries );
+	}
+
+	load_filename = savegame;
+	checksum = 0;
+	int regressions = 0;
+
+	cbuffer_t buf;
+	buf.append( "{\"version\":" );
+	append_json_string( buf, VERSION_NUMBER );
+	buf.append( ",\"savegame\":" );
+	append_json_string( buf, savegame );
+	buf.append( ",\"suite\":" );
+	append_json_string( buf, suite );
+	// the chunks for the first load of the game in this process
+	uint64 start_chunks, start_chunk_bytes;
+	freelist_t::get_chunk_stats( start_chunks, start_chunk_bytes );
+	buf.printf( ",\"threads\":%u,\"plan_block_bits\":%i,\"bulk_alloc\":%s,\"start_chunks\":%llu,\"start_chunk_kb\":%llu,\n\"scenarios\":[\n",
+		env_t::num_threads, PLAN_BLOCK_BITS, freelist_t::is_bulk_mode_allowed() ? "true" : "false",
+		(unsigned long long)start_chunks, (unsigned long long)(start_chunk_bytes >> 10) );
+
+	bool first = true;
+	for(  uint32 n = 0;  n < lengthof(scenarios);  n++  ) {
+		const scenario_t &s = scenarios[n];
+		if(  !is_selected( s, suite )  ) {
+			continue;
+		}
+		if(  s.available  &&  !s.available( welt )  ) {
+			dbg->message( "benchmark_t::run()", "Skipping %s, not possible with this game", s.name );
+			continue;
+		}
+
+		// same random numbers for every run
+		bench_seed = 1;
+		if(  s.setup  ) {
+			s.setup( welt );
+		}
+		if(  s.samples >= 10  ) {
+			s.run( welt, view, s.ops );
+		}
+
+		// freed nodes are reused, so only new chunks show the cost of allocation
+		uint64 chunks_before, chunk_bytes_before;
+		freelist_t::get_chunk_stats( chunks_before, chunk_bytes_before );
+
+		vector_tpl<uint64> times( s.samples );
+		uint64 total_us = 0;
+		for(  uint32 i = 0;  i < s.samples;  i++  ) {
+			const uint64 start_us = get_time_us();
+			s.run( welt, view, s.ops );
+			times.append( get_time_us() - start_us );
+			total_us += times.back();
+		}
+		uint64 chunks, chunk_bytes;
+		freelist_t::get_chunk_stats( chunks, chunk_bytes );
+		chunks -= chunks_before;
+		chunk_bytes -= chunk_bytes_before;
+
+		std::sort( times.begin(), times.end() );
+		if(  s.cleanup  ) {
+			s.cleanup( welt );
+		}
+
+		const uint64 median_us = percentile( times, 50 );
+		buf.printf( "%s{\"name\":\"%s\",\"group\":\"%s\",\"samples\":%u,\"ops\":%u,\"min_us\":%llu,\"median_us\":%llu,\"p90_us\":%llu,\"p99_us\":%llu,\"max_us\":%llu,\"mean_us\":%llu",
+			first ? "" : ",", s.name, s.group, s.samples, s.ops,
+			(unsigned long long)times[0], (unsigned long long)median_us, (unsigned long long)percentile( times, 90 ),
+			(unsigned long long)percentile( times, 99 ), (unsigned long long)times.back(), (unsigned long long)(total_us / s.samples) );
+		buf.printf( ",\"chunks\":%llu,\"chunk_kb\":%llu", (unsigned long long)chunks, (unsigned long long)(chunk_bytes >> 10) );
+		first = false;
+
+		for(baseline_entry_t const& e : baseline_entries) {
+			if(  e.name == s.name  &&  e.median_us > 0  ) {
+				const sint64 change = ((sint64)median_us - (sint64)e.median_us) * 100 / (sint64)e.median_us;
+				const bool regression = change > BENCHMARK_TOLERANCE_PERCENT;
+				buf.printf( ",\"baseline_median_us\":%llu,\"change_percent\":%lli,\"regression\":%s",
+					(unsigned long long)e.median_us, (long long)change, regression ? "true" : "false" );
+				if(  regression  ) {
+					dbg->warning( "benchmark_t::run()", "%s: median %llu us is %lli%% slower than baseline", s.name, (unsigned long long)median_us, (long long)change );
+					regressions ++;
+				}
+				break;
+			}
+		}
+		buf.append( "}\n" );
+
+		dbg->message( "benchmark_t::run()", "%s: median %llu us, p90 %llu us (%u samples of %u ops)", s.name, (unsigned long long)median_us, (unsigned long long)percentile( times, 90 ), s.samples, s.ops );
+	}
+	buf.printf( "],\"regressions\":%i,\"checksum\":%i}\n", regressions, checksum );
+
+	dr_remove( BENCHMARK_SAVE );
+
+	printf( "%s", (const char *)buf );
+	if(  FILE *f = dr_fopen( BENCHMARK_FILE, "w" )  ) {
+		fputs( buf, f );
+		fclose( f );
+	}
+	else {
+		dbg->warning( "benchmark_t::run()", "Cannot write '%s'", BENCHMARK_FILE );
+	}
+
+	return regressions;
+}
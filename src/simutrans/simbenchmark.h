@@ -0,0 +1,44 @@
+/*
+ * This file is part of the Simutrans project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#ifndef SIMBENCHMARK_H
+#define SIMBENCHMARK_H
+
+
+#include "simtypes.h"
+
+class karte_t;
+class main_view_t;
+
+/// default file name for the results (relative to the user directory)
+#define BENCHMARK_FILE "benchmark.json"
+
+/// a scenario is a regression, if its median is slower than the baseline by more than this
+#define BENCHMARK_TOLERANCE_PERCENT (10)
+
+
+/**
+ * Repeatable benchmark scenarios on a loaded game (command line -benchmark).
+ * Every scenario is run a fixed number of times and min, median, percentiles
+ * and max of the runs are written as JSON, one scenario per line.
+ * If a baseline (an older result file) is given, the medians are compared.
+ */
+class benchmark_t
+{
+public:
+	/**
+	 * Runs all scenarios matching @p suite, which is "all", a group (render, sim, map, io)
+	 * or the name of a single scenario.
+	 * @param savegame file the world was loaded from, used by the load scenario
+	 * @param baseline result file of an earlier run or NULL
+	 * @return number of scenarios slower than the baseline
+	 */
+	static int run(karte_t *welt, main_view_t *view, const char *suite, const char *savegame, const char *baseline);
+
+	/// monthly actions of the world, which are otherwise only called by the world itself
+	static void new_month(karte_t *welt);
+};
+
+#endif
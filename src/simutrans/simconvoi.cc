@@ -137,6 +137,7 @@ void convoi_t::init(player_t *player)
 	sum_speed_limit = 0;
 	maxspeed_average_count = 0;
 	next_reservation_index = 0;
+	reservation_count = 0;
 
 	alte_richtung = ribi_t::none;
 	next_wolke = 0;
@@ -216,6 +216,9 @@ private:
 	/// It is used for restoring reservations after loading a game.
 	route_t::index_t next_reservation_index;
 
+	/// counts the track tiles reserved by this convoi, never saved
+	uint32 reservation_count;
+
 	/// caches the running costs
 	sint32 sum_running_costs;
 	sint32 sum_fixed_costs;
@@ -742,6 +745,10 @@ public:
 	route_t::index_t get_next_reservation_index() { return next_reservation_index; }
 	void set_next_reservation_index(route_t::index_t n);
 
+	/// changes whenever this convoi reserves a track tile it did not hold before
+	uint32 get_reservation_count() const { return reservation_count; }
+	void count_reservation() { reservation_count++; }
+
 	/* the current state of the convoi */
 	PIXVAL get_status_color() const;
 
@@ -48,6 +48,7 @@
 #include "gui/halt_info.h"
 #include "gui/minimap.h"
 
+#include "utils/profiler.h"
 #include "utils/simrandom.h"
 #include "utils/simstring.h"
 
@@ -76,6 +77,89 @@ static vector_tpl<convoihandle_t>stale_convois;
 static vector_tpl<linehandle_t>stale_lines;
 
 
+/// removes packets without amount, keeps the order of the others
+static void remove_empty_wares(vector_tpl<ware_t> &wares)
+{
+	uint32 n = 0;
+	for(  uint32 i=0;  i<wares.get_count();  i++  ) {
+		if(  wares[i].amount > 0  ) {
+			if(  n != i  ) {
+				wares[n] = wares[i];
+			}
+			n++;
+		}
+	}
+	while(  wares.get_count() > n  ) {
+		wares.pop_back();
+	}
+}
+
+
+halt_cargo_t::~halt_cargo_t()
+{
+	for(bucket_t *b : buckets) {
+		delete b;
+	}
+}
+
+
+vector_tpl<ware_t> *halt_cargo_t::get(halthandle_t via) const
+{
+	for(bucket_t *b : buckets) {
+		if(  b->via == via  ) {
+			return &b->wares;
+		}
+	}
+	return NULL;
+}
+
+
+void halt_cargo_t::append(const ware_t &ware)
+{
+	vector_tpl<ware_t> *wares = get( ware.get_via_halt() );
+	if(  wares == NULL  ) {
+		bucket_t *b = new bucket_t;
+		b->via = ware.get_via_halt();
+		buckets.append( b );
+		wares = &b->wares;
+	}
+	wares->append( ware );
+}
+
+
+uint32 halt_cargo_t::get_count() const
+{
+	uint32 count = 0;
+	for(bucket_t const* b : buckets) {
+		count += b->wares.get_count();
+	}
+	return count;
+}
+
+
+void halt_cargo_t::compact()
+{
+	for(  uint32 i=buckets.get_count();  i-- > 0;  ) {
+		remove_empty_wares( buckets[i]->wares );
+		if(  buckets[i]->wares.empty()  ) {
+			delete buckets[i];
+			buckets.remove_at( i );
+		}
+	}
+}
+
+
+void halt_cargo_t::get_all(vector_tpl<ware_t> &list) const
+{
+	list.reserve( list.get_count() + get_count() );
+	for(bucket_t const* b : buckets) {
+		for(ware_t const& w : b->wares) {
+			list.append( w );
+		}
+	}
+}
+
+
 void haltestelle_t::reset_routing()
 {
 	reconnect_counter = welt->get_schedule_counter()-1;
@@ -470,7 +554,7 @@ haltestelle_t::haltestelle_t(loadsave_t* file)
 {
 	last_loading_step = welt->get_steps();
 
-	cargo = (vector_tpl<ware_t> **)calloc( goods_manager_t::get_max_catg_index(), sizeof(vector_tpl<ware_t> *) );
+	cargo = (halt_cargo_t **)calloc( goods_manager_t::get_max_catg_index(), sizeof(halt_cargo_t *) );
 	all_links = new link_t[ goods_manager_t::get_max_catg_index() ];
 	halt_served_this_step = new vector_tpl<halthandle_t>[goods_manager_t::get_max_catg_index()];
 
@@ -483,6 +567,8 @@ haltestelle_t::haltestelle_t(loadsave_t* file)
 	enables = NOT_ENABLED;
 
 	old_sort_mode = 255;
+	freight_amounts_changed = false;
+	freight_summary = NULL;
 
 	rdwr(file);
 
@@ -510,7 +596,7 @@ haltestelle_t::haltestelle_t(koord k, player_t* player)
 	reconnect_counter = welt->get_schedule_counter()-1;
 	last_catg_index = 255;
 
-	cargo = (vector_tpl<ware_t> **)calloc( goods_manager_t::get_max_catg_index(), sizeof(vector_tpl<ware_t> *) );
+	cargo = (halt_cargo_t **)calloc( goods_manager_t::get_max_catg_index(), sizeof(halt_cargo_t *) );
 	all_links = new link_t[ goods_manager_t::get_max_catg_index() ];
 	halt_served_this_step = new vector_tpl<halthandle_t>[goods_manager_t::get_max_catg_index()];
 
@@ -518,6 +604,10 @@ haltestelle_t::haltestelle_t(koord k, player_t* player)
 	last_status_color = color_idx_to_rgb(COL_PURPLE);
 	last_bar_count = 0;
 
+	old_sort_mode = 255;
+	freight_amounts_changed = false;
+	freight_summary = NULL;
+
 	init_financial_history();
 }
 
@@ -525,6 +615,7 @@ haltestelle_t::haltestelle_t(koord k, player_t* player)
 haltestelle_t::~haltestelle_t()
 {
 	assert(self.is_bound());
+	invalidate_route_cache();
 
 	// first: remove halt from all lists
 	int i=0;
@@ -574,8 +665,10 @@ haltestelle_t::~haltestelle_t()
 
 	for(unsigned i=0; i<goods_manager_t::get_max_catg_index(); i++) {
 		if (cargo[i]) {
-			for(ware_t const &w : *cargo[i]) {
-				fabrik_t::update_transit(&w, false);
+			for(halt_cargo_t::bucket_t const* b : cargo[i]->get_buckets()) {
+				for(ware_t const &w : b->wares) {
+					fabrik_t::update_transit(&w, false);
+				}
 			}
 			delete cargo[i];
 			cargo[i] = NULL;
@@ -584,6 +677,7 @@ haltestelle_t::~haltestelle_t()
 	free( cargo );
 	delete[] all_links;
 	delete[] halt_served_this_step;
+	delete freight_summary;
 
 	// routes may have changed without this station ...
 	verbinde_fabriken();
@@ -598,17 +692,15 @@ void haltestelle_t::rotate90( const sint16 y_size )
 	// iterate over all different categories
 	for(unsigned i=0; i<goods_manager_t::get_max_catg_index(); i++) {
 		if(cargo[i]) {
-			vector_tpl<ware_t>& warray = *cargo[i];
-			for (size_t j = warray.get_count(); j-- != 0;) {
-				ware_t& ware = warray[j];
-				if(ware.amount>0) {
-					ware.rotate90(y_size);
-				}
-				else {
-					// empty => remove
-					warray.remove_at(j);
+			for(halt_cargo_t::bucket_t* b : cargo[i]->get_buckets()) {
+				for(ware_t &ware : b->wares) {
+					if(ware.amount>0) {
+						ware.rotate90(y_size);
+					}
 				}
 			}
+			// empty => remove
+			cargo[i]->compact();
 		}
 	}
 
@@ -1097,11 +1189,12 @@ void haltestelle_t::reroute_goods(sint16 &units_remaining)
 		if(cargo[last_catg_index]) {
 
 			// first: clean out the array
-			vector_tpl<ware_t> * warray = cargo[last_catg_index];
-			vector_tpl<ware_t> * new_warray = new vector_tpl<ware_t>(warray->get_count());
+			vector_tpl<ware_t> warray;
+			cargo[last_catg_index]->get_all( warray );
+			vector_tpl<ware_t> new_warray(warray.get_count());
 
-			for (size_t j = warray->get_count(); j-- != 0;) {
-				ware_t & ware = (*warray)[j];
+			for (size_t j = warray.get_count(); j-- != 0;) {
+				ware_t & ware = warray[j];
 
 				if(ware.amount==0) {
 					continue;
@@ -1117,40 +1210,31 @@ void haltestelle_t::reroute_goods(sint16 &units_remaining)
 				}
 
 				// add to new array
-				new_warray->append( ware );
-			}
-
-			// delete, if nothing connects here
-			if(  new_warray->empty()  ) {
-				if(  all_links[last_catg_index].connections.empty()  ) {
-					// no connections from here => delete
-					delete new_warray;
-					new_warray = NULL;
-				}
+				new_warray.append( ware );
 			}
 
 			// replace the array
 			delete cargo[last_catg_index];
-			cargo[last_catg_index] = new_warray;
+			cargo[last_catg_index] = NULL;
+
+			// delete, if nothing connects here
+			if(  !new_warray.empty()  ||  !all_links[last_catg_index].connections.empty()  ) {
+				cargo[last_catg_index] = new halt_cargo_t();
+			}
 
 			// if something left
 			// re-route goods to adapt to changes in world layout,
 			// remove all goods whose destination was removed from the map
-			if (cargo[last_catg_index] && !cargo[last_catg_index]->empty()) {
-
-				vector_tpl<ware_t> &warray = *cargo[last_catg_index];
-				uint32 last_goods_index = 0;
-				units_remaining -= warray.get_count();
-				while(  last_goods_index<warray.get_count()  ) {
-					search_route_resumable(warray[last_goods_index]);
-					if(  warray[last_goods_index].get_target_halt()==halthandle_t()  ) {
-						// remove invalid destinations
-						fabrik_t::update_transit( &warray[last_goods_index], false);
-						warray.remove_at(last_goods_index);
-					}
-					else {
-						++last_goods_index;
-					}
+			// the new routes decide the new buckets
+			units_remaining -= new_warray.get_count();
+			for(ware_t & ware : new_warray) {
+				search_route_resumable(ware);
+				if(  ware.get_target_halt()==halthandle_t()  ) {
+					// remove invalid destinations
+					fabrik_t::update_transit( &ware, false);
+				}
+				else {
+					cargo[last_catg_index]->append( ware );
 				}
 			}
 		}
@@ -1236,6 +1320,7 @@ sint32 haltestelle_t::rebuild_connections()
 		all_links[i].clear();
 		consecutive_halts[i].clear();
 	}
+	invalidate_route_cache();
 	old_sort_mode = 255; // might result in error in routing
 
 	last_catg_index = 255; // must reroute everything
@@ -1408,6 +1493,7 @@ void haltestelle_t::fill_connected_component(uint8 catg_idx, uint16 comp)
 
 void haltestelle_t::rebuild_connected_components()
 {
+	invalidate_route_cache();
 	for(uint8 catg_idx = 0; catg_idx<goods_manager_t::get_max_catg_index(); catg_idx++) {
 		for(halthandle_t halt : alle_haltestellen) {
 			if (halt->all_links[catg_idx].catg_connected_component == UNDECIDED_CONNECTED_COMPONENT) {
@@ -1571,6 +1657,7 @@ uint8 haltestelle_t::last_search_ware_catg_idx = 255;
  */
 int haltestelle_t::search_route( const halthandle_t *const start_halts, const uint16 start_halt_count, const bool no_routing_over_overcrowding, ware_t &ware, ware_t *const return_ware )
 {
+	profile_scope_t const profile_routing(PROFILE_ROUTING);
 	const uint8 ware_catg_idx = ware.get_desc()->get_catg_index();
 	const uint8 ware_idx = ware.get_desc()->get_index();
 
@@ -1835,6 +1922,120 @@ int haltestelle_t::search_route( const halthandle_t *const start_halts, const ui
 }
 
 
+/// halt ids of start halts and target tile halts, longer lists are not cached
+#define ROUTE_CACHE_MAX_HALTS (24)
+/// must be a power of two
+#define ROUTE_CACHE_SIZE (4096)
+
+struct route_cache_entry_t
+{
+	uint32 serial = 0; ///< entry is only valid if equal to route_cache_serial
+	uint16 halt_ids[ROUTE_CACHE_MAX_HALTS] = {};
+	uint8 start_count = 0;
+	uint8 end_count = 0;
+	uint8 ware_idx = 0;
+	bool no_routing_over_overcrowding = false;
+	bool resets_search = false;
+	sint8 result = 0;
+	halthandle_t target_halt, via_halt;
+	halthandle_t return_target_halt, return_via_halt;
+};
+
+static route_cache_entry_t route_cache[ROUTE_CACHE_SIZE];
+static uint32 route_cache_serial = 1;
+static sint32 route_cache_max_transfers = -1;
+static sint32 route_cache_max_hops = -1;
+
+
+void haltestelle_t::invalidate_route_cache()
+{
+	if(  ++route_cache_serial == 0  ) {
+		// wrapped around: old entries could become valid again
+		for(  route_cache_entry_t &e : route_cache  ) {
+			e = route_cache_entry_t();
+		}
+		route_cache_serial = 1;
+	}
+}
+
+
+int haltestelle_t::search_route_batched( const halthandle_t *const start_halts, const uint16 start_halt_count, const bool no_routing_over_overcrowding, ware_t &ware, ware_t *const return_ware )
+{
+	const planquadrat_t *const plan = welt->access( ware.get_target_pos() );
+	const uint8 end_count = plan->get_haltlist_count();
+	if(  start_halt_count + end_count > ROUTE_CACHE_MAX_HALTS  ) {
+		return search_route( start_halts, start_halt_count, no_routing_over_overcrowding, ware, return_ware );
+	}
+
+	settings_t const& s = welt->get_settings();
+	if(  route_cache_max_transfers != s.get_max_transfers()  ||  route_cache_max_hops != s.get_max_hops()  ) {
+		route_cache_max_transfers = s.get_max_transfers();
+		route_cache_max_hops = s.get_max_hops();
+		invalidate_route_cache();
+	}
+	// build the key: start halts and all halts (even disabled ones) on the target tile
+	route_cache_entry_t key;
+	const halthandle_t *const halt_list = plan->get_haltlist();
+	uint32 hash = ware.get_desc()->get_index() * 31u + no_routing_over_overcrowding;
+	for(  uint16 i=0;  i<start_halt_count;  i++  ) {
+		key.halt_ids[i] = start_halts[i].get_id();
+		hash = hash * 65599u + key.halt_ids[i];
+	}
+	hash = hash * 65599u + 0xFFFFu;
+	for(  uint8 i=0;  i<end_count;  i++  ) {
+		key.halt_ids[start_halt_count+i] = halt_list[i].get_id();
+		hash = hash * 65599u + key.halt_ids[start_halt_count+i];
+	}
+	key.start_count = (uint8)start_halt_count;
+	key.end_count = end_count;
+	key.ware_idx = ware.get_desc()->get_index();
+	key.no_routing_over_overcrowding = no_routing_over_overcrowding;
+
+	route_cache_entry_t &entry = route_cache[ (hash ^ (hash >> 16)) & (ROUTE_CACHE_SIZE-1) ];
+	if(  entry.serial == route_cache_serial
+		&&  entry.start_count == key.start_count  &&  entry.end_count == key.end_count
+		&&  entry.ware_idx == key.ware_idx  &&  entry.no_routing_over_overcrowding == key.no_routing_over_overcrowding
+		&&  memcmp( entry.halt_ids, key.halt_ids, sizeof(key.halt_ids) ) == 0  ) {
+		// same search as before: same side effects as search_route()
+		ware.set_target_halt( entry.target_halt );
+		ware.set_via_halt( entry.via_halt );
+		if(  return_ware  ) {
+			return_ware->set_target_halt( entry.return_target_halt );
+			return_ware->set_via_halt( entry.return_via_halt );
+		}
+		if(  entry.resets_search  ) {
+			last_search_origin = halthandle_t();
+		}
+		return entry.result;
+	}
+
+	// the return route is always needed for the cache
+	ware_t return_tmp( ware.get_desc() );
+	const int result = search_route( start_halts, start_halt_count, no_routing_over_overcrowding, ware, &return_tmp );
+	if(  return_ware  ) {
+		return_ware->set_target_halt( return_tmp.get_target_halt() );
+		return_ware->set_via_halt( return_tmp.get_via_halt() );
+	}
+
+	key.serial = route_cache_serial;
+	key.result = (sint8)result;
+	key.target_halt = ware.get_target_halt();
+	key.via_halt = ware.get_via_halt();
+	key.return_target_halt = return_tmp.get_target_halt();
+	key.return_via_halt = return_tmp.get_via_halt();
+	// search_route() only touches the search history, if there was an enabled target halt and no walk
+	key.resets_search = false;
+	if(  result != ROUTE_WALK  ) {
+		const uint8 catg_idx = ware.get_desc()->get_catg_index();
+		for(  uint8 i=0;  i<end_count;  i++  ) {
+			key.resets_search |= halt_list[i].is_bound()  &&  halt_list[i]->is_enabled(catg_idx);
+		}
+	}
+	entry = key;
+	return result;
+}
+
+
 void haltestelle_t::search_route_resumable(  ware_t &ware   )
 {
 	const uint8 ware_catg_idx = ware.get_desc()->get_catg_index();
@@ -2110,29 +2311,32 @@ void haltestelle_t::liefere_an_fabrik(const ware_t& ware) const
 bool haltestelle_t::recall_ware( ware_t& w, uint32 menge )
 {
 	w.amount = 0;
-	vector_tpl<ware_t> *warray = cargo[w.get_desc()->get_catg_index()];
-	if(warray!=NULL) {
-		for(ware_t & tmp : *warray) {
-			// skip empty entries
-			if(tmp.amount==0  ||  w.get_index()!=tmp.get_index()  ||  w.get_target_pos()!=tmp.get_target_pos()) {
-				continue;
-			}
+	halt_cargo_t *cargo_list = cargo[w.get_desc()->get_catg_index()];
+	if(cargo_list!=NULL) {
+		for(halt_cargo_t::bucket_t *b : cargo_list->get_buckets()) {
+			for(ware_t & tmp : b->wares) {
+				// skip empty entries
+				if(tmp.amount==0  ||  w.get_index()!=tmp.get_index()  ||  w.get_target_pos()!=tmp.get_target_pos()) {
+					continue;
+				}
 
-			// not too much?
-			if(tmp.amount > menge) {
-				// not all can be loaded
-				tmp.amount -= menge;
-				w.amount = menge;
-			}
-			else {
-				// leave an empty entry => joining will more often work
-				w.amount = tmp.amount;
-				tmp.amount = 0;
+				// not too much?
+				if(tmp.amount > menge) {
+					// not all can be loaded
+					tmp.amount -= menge;
+					w.amount = menge;
+					freight_amounts_changed = true;
+				}
+				else {
+					w.amount = tmp.amount;
+					tmp.amount = 0;
+					remove_empty_wares( b->wares );
+					old_sort_mode = 255;
+				}
+				book(w.amount, HALT_ARRIVED);
+				fabrik_t::update_transit( &w, false );
+				return true;
 			}
-			book(w.amount, HALT_ARRIVED);
-			fabrik_t::update_transit( &w, false );
-			old_sort_mode = 255;
-			return true;
 		}
 	}
 	// nothing to take out
@@ -2146,15 +2350,39 @@ void haltestelle_t::fetch_goods( slist_tpl<ware_t> &load, const goods_desc_t *go
 	// first iterate over the next stop, then over the ware
 	// might be a little slower, but ensures that passengers to nearest stop are served first
 	// this allows for separate high speed and normal service
-	vector_tpl<ware_t> *warray = cargo[good_category->get_catg_index()];
+	halt_cargo_t *cargo_list = cargo[good_category->get_catg_index()];
+
+	if(  cargo_list  &&  cargo_list->get_count() > 0  ) {
+		// goods without route -> returning passengers/mail
+		vector_tpl<ware_t> *unrouted = cargo_list->get( halthandle_t() );
+		if(  unrouted  &&  !unrouted->empty()  ) {
+			vector_tpl<ware_t> route_now;
+			swap( route_now, *unrouted );
+			for(ware_t & tmp : route_now) {
+				if(  tmp.amount > 0  ) {
+					search_route_resumable(tmp);
+					if(  tmp.get_target_halt().is_bound()  ) {
+						cargo_list->append( tmp );
+					}
+					// else no route anymore
+				}
+			}
+			old_sort_mode = 255;
+		}
 
-	if(  warray  &&  !warray->empty()  ) {
 		for(  uint32 i=0; i < destination_halts.get_count();  i++  ) {
 			halthandle_t plan_halt = destination_halts[i];
 
 			// mark this stop as served, even if I do not load to avoid stealing transfer freight by later processed convois
 			halt_served_this_step[good_category->get_catg_index()].append_unique(plan_halt);
 
+			// only the goods going to this next stop
+			vector_tpl<ware_t> *warray = cargo_list->get( plan_halt );
+			if(  warray == NULL  ||  warray->empty()  ) {
+				// nothing there to load
+				continue;
+			}
+
 			// The random offset will ensure that all goods have an equal chance to be loaded.
 			uint32 offset = simrand(warray->get_count());
 			for(  uint32 i=0;  i<warray->get_count();  i++  ) {
@@ -2170,49 +2398,42 @@ void haltestelle_t::fetch_goods( slist_tpl<ware_t> &load, const goods_desc_t *go
 					continue;
 				}
 
-				// goods without route -> returning passengers/mail
-				if(  !tmp.get_via_halt().is_bound()  ) {
-					search_route_resumable(tmp);
-					if (!tmp.get_target_halt().is_bound()) {
-						// no route anymore
-						tmp.amount = 0;
+				if(  plan_halt->is_overcrowded( tmp.get_index() )  ) {
+					if (welt->get_settings().is_avoid_overcrowding() && tmp.get_target_halt() != plan_halt) {
+						// do not go for transfer to overcrowded transfer stop
 						continue;
 					}
 				}
 
-				// compatible car and right target stop?
-				if(  tmp.get_via_halt()==plan_halt  ) {
-					if(  plan_halt->is_overcrowded( tmp.get_index() )  ) {
-						if (welt->get_settings().is_avoid_overcrowding() && tmp.get_target_halt() != plan_halt) {
-							// do not go for transfer to overcrowded transfer stop
-							continue;
-						}
-					}
-
-					// not too much?
-					ware_t neu(tmp);
-					if(  tmp.amount > requested_amount  ) {
-						// not all can be loaded
-						neu.amount = requested_amount;
-						tmp.amount -= requested_amount;
-						requested_amount = 0;
-					}
-					else {
-						requested_amount -= tmp.amount;
-						// leave an empty entry => joining will more often work
-						tmp.amount = 0;
-					}
-					load.insert(neu);
-
-					book(neu.amount, HALT_DEPARTED);
+				// not too much?
+				ware_t neu(tmp);
+				if(  tmp.amount > requested_amount  ) {
+					// not all can be loaded
+					neu.amount = requested_amount;
+					tmp.amount -= requested_amount;
+					requested_amount = 0;
+					freight_amounts_changed = true;
+				}
+				else {
+					requested_amount -= tmp.amount;
+					tmp.amount = 0;
+					// packet will be removed
 					old_sort_mode = 255;
+				}
+				load.insert(neu);
 
-					if (requested_amount==0) {
-						return;
-					}
+				book(neu.amount, HALT_DEPARTED);
+
+				if (requested_amount==0) {
+					break;
 				}
 			}
-			// nothing there to load
+			// fully loaded packets are removed
+			remove_empty_wares( *warray );
+
+			if (requested_amount==0) {
+				return;
+			}
 		}
 	}
 }
@@ -2222,11 +2443,13 @@ void haltestelle_t::fetch_goods( slist_tpl<ware_t> &load, const goods_desc_t *go
 uint32 haltestelle_t::get_ware_summe(const goods_desc_t *wtyp) const
 {
 	int sum = 0;
-	const vector_tpl<ware_t> * warray = cargo[wtyp->get_catg_index()];
-	if(warray!=NULL) {
-		for(ware_t const& i : *warray) {
-			if (wtyp->get_index() == i.get_index()) {
-				sum += i.amount;
+	const halt_cargo_t * cargo_list = cargo[wtyp->get_catg_index()];
+	if(cargo_list!=NULL) {
+		for(halt_cargo_t::bucket_t const* b : cargo_list->get_buckets()) {
+			for(ware_t const& i : b->wares) {
+				if (wtyp->get_index() == i.get_index()) {
+					sum += i.amount;
+				}
 			}
 		}
 	}
@@ -2236,11 +2459,13 @@ uint32 haltestelle_t::get_ware_summe(const goods_desc_t *wtyp) const
 
 uint32 haltestelle_t::get_ware_fuer_zielpos(const goods_desc_t *wtyp, const koord zielpos) const
 {
-	const vector_tpl<ware_t> * warray = cargo[wtyp->get_catg_index()];
-	if(warray!=NULL) {
-		for(ware_t const& ware : *warray) {
-			if(wtyp->get_index()==ware.get_index()  &&  ware.get_target_pos()==zielpos) {
-				return ware.amount;
+	const halt_cargo_t * cargo_list = cargo[wtyp->get_catg_index()];
+	if(cargo_list!=NULL) {
+		for(halt_cargo_t::bucket_t const* b : cargo_list->get_buckets()) {
+			for(ware_t const& ware : b->wares) {
+				if(wtyp->get_index()==ware.get_index()  &&  ware.get_target_pos()==zielpos) {
+					return ware.amount;
+				}
 			}
 		}
 	}
@@ -2251,12 +2476,13 @@ uint32 haltestelle_t::get_ware_fuer_zielpos(const goods_desc_t *wtyp, const koor
 uint32 haltestelle_t::get_ware_fuer_zwischenziel(const goods_desc_t *wtyp, const halthandle_t zwischenziel) const
 {
 	uint32 sum = 0;
-	const vector_tpl<ware_t> * warray = cargo[wtyp->get_catg_index()];
-	if(warray!=NULL) {
-		for(unsigned i=0;  i<warray->get_count();  i++ ) {
-			const ware_t &ware = (*warray)[i];
-			if(wtyp->get_index()==ware.get_index()  &&  ware.get_via_halt()==zwischenziel) {
-				sum += ware.amount;
+	const halt_cargo_t * cargo_list = cargo[wtyp->get_catg_index()];
+	if(cargo_list!=NULL) {
+		if(  const vector_tpl<ware_t> *warray = cargo_list->get(zwischenziel)  ) {
+			for(ware_t const& ware : *warray) {
+				if(wtyp->get_index()==ware.get_index()) {
+					sum += ware.amount;
+				}
 			}
 		}
 	}
@@ -2267,18 +2493,48 @@ uint32 haltestelle_t::get_ware_fuer_zwischenziel(const goods_desc_t *wtyp, const
 bool haltestelle_t::vereinige_waren(const ware_t &ware)
 {
 	// pruefen ob die ware mit bereits wartender ware vereinigt werden kann
-	vector_tpl<ware_t> * warray = cargo[ware.get_desc()->get_catg_index()];
-	if(warray!=NULL) {
-		for(ware_t & tmp : *warray) {
-			// join packets with same destination
-			if(ware.same_destination(tmp)) {
-				if(  ware.get_via_halt().is_bound()  &&  ware.get_via_halt()!=self  ) {
-					// update route if there is newer route
-					tmp.set_via_halt( ware.get_via_halt() );
-				}
-				tmp.amount += ware.amount;
-				old_sort_mode = 255;
-				return true;
+	// only packets with the same next stop are joined
+	halt_cargo_t * cargo_list = cargo[ware.get_desc()->get_catg_index()];
+	if(cargo_list!=NULL) {
+		if(  vector_tpl<ware_t> *warray = cargo_list->get(ware.get_via_halt())  ) {
+			for(ware_t & tmp : *warray) {
+				// join packets with same destination
+				if(ware.same_destination(tmp)) {
+					tmp.amount += ware.amount;
+					freight_amounts_changed = true;
+					return true;
+				}
+			}
+		}
+	}
+	return false;
+}
+
+
+
+bool haltestelle_t::vereinige_waren_any_via(const ware_t &ware)
+{
+	halt_cargo_t * cargo_list = cargo[ware.get_desc()->get_catg_index()];
+	if(cargo_list!=NULL) {
+		for(halt_cargo_t::bucket_t * b : cargo_list->get_buckets()) {
+			for(ware_t & tmp : b->wares) {
+				// join packets with same destination
+				if(  ware.same_destination(tmp)  ) {
+					if(  ware.get_via_halt().is_bound()  &&  ware.get_via_halt()!=self  &&  ware.get_via_halt()!=b->via  ) {
+						// update route if there is newer route, i.e. move to the other next stop
+						ware_t moved(tmp);
+						moved.amount += ware.amount;
+						moved.set_via_halt( ware.get_via_halt() );
+						tmp.amount = 0;
+						cargo_list->append( moved );
+						old_sort_mode = 255;
+					}
+					else {
+						tmp.amount += ware.amount;
+						freight_amounts_changed = true;
+					}
+					return true;
+				}
 			}
 		}
 	}
@@ -2292,22 +2548,14 @@ bool haltestelle_t::vereinige_waren(const ware_t &ware)
 void haltestelle_t::add_ware_to_halt(ware_t ware)
 {
 	// now we have to add the ware to the stop
-	vector_tpl<ware_t> * warray = cargo[ware.get_desc()->get_catg_index()];
-	if(warray==NULL) {
+	halt_cargo_t * cargo_list = cargo[ware.get_desc()->get_catg_index()];
+	if(cargo_list==NULL) {
 		// this type was not stored here before ...
-		warray = new vector_tpl<ware_t>(4);
-		cargo[ware.get_desc()->get_catg_index()] = warray;
+		cargo_list = new halt_cargo_t();
+		cargo[ware.get_desc()->get_catg_index()] = cargo_list;
 	}
-	// the ware will be put into the first entry with menge==0
 	old_sort_mode = 255;
-	for(ware_t & i : *warray) {
-		if (i.amount == 0) {
-			i = ware;
-			return;
-		}
-	}
-	// here, if no free entries found
-	warray->append(ware);
+	cargo_list->append(ware);
 }
 
 
@@ -2384,7 +2632,7 @@ dbg->warning("haltestelle_t::liefere_an()","%d %s delivered to %s have no longer
 	}
 
 	// do we have already something going in this direction here?
-	if(  vereinige_waren(ware)  ) {
+	if(  vereinige_waren_any_via(ware)  ) {
 		return ware.amount;
 	}
 
@@ -2398,7 +2646,7 @@ dbg->warning("haltestelle_t::liefere_an()","%d %s delivered to %s have no longer
 		return ware.amount;
 	}
 	// try to join with existing freight only if target has changed
-	if(old_target != ware.get_target_halt()  &&  vereinige_waren(ware)) {
+	if(  old_target != ware.get_target_halt()  &&  vereinige_waren(ware)  ) {
 		return ware.amount;
 	}
 	// add to internal storage
@@ -2413,18 +2661,29 @@ dbg->warning("haltestelle_t::liefere_an()","%d %s delivered to %s have no longer
  */
 void haltestelle_t::get_freight_info(cbuffer_t & buf)
 {
-	if(old_sort_mode != env_t::default_sortmode) {
-		// resort only inf absolutely needed ...
-		old_sort_mode = env_t::default_sortmode;
-		buf.clear();
+	if(  old_sort_mode == env_t::default_sortmode  &&  !freight_amounts_changed  ) {
+		return;
+	}
 
-		for(unsigned i=0; i<goods_manager_t::get_max_catg_index(); i++) {
-			const vector_tpl<ware_t> * warray = cargo[i];
-			if(warray) {
-				freight_list_sorter_t::sort_freight(*warray, buf, (freight_list_sorter_t::sort_mode_t)env_t::default_sortmode, NULL, "waiting", this->self);
-			}
+	vector_tpl<ware_t> warray;
+	for(unsigned i=0; i<goods_manager_t::get_max_catg_index(); i++) {
+		if(cargo[i]) {
+			cargo[i]->get_all(warray);
 		}
 	}
+
+	if(  freight_summary == NULL  ) {
+		freight_summary = new freight_summary_t();
+	}
+	// resort only if packets were added or removed
+	if(  old_sort_mode != env_t::default_sortmode  ||  !freight_summary->update_amounts(warray)  ) {
+		old_sort_mode = env_t::default_sortmode;
+		freight_summary->build(warray, (freight_list_sorter_t::sort_mode_t)env_t::default_sortmode, self);
+	}
+	freight_amounts_changed = false;
+
+	buf.clear();
+	freight_summary->print(buf, NULL, "waiting");
 }
 
 
@@ -2642,10 +2901,11 @@ void haltestelle_t::transfer_goods(halthandle_t halt)
 	}
 	// transfer goods to halt
 	for(uint8 i=0; i<goods_manager_t::get_max_catg_index(); i++) {
-		const vector_tpl<ware_t> * warray = cargo[i];
-		if (warray) {
-			for(ware_t const& j : *warray) {
-				halt->add_ware_to_halt(j);
+		if (cargo[i]) {
+			for(halt_cargo_t::bucket_t const* b : cargo[i]->get_buckets()) {
+				for(ware_t const& j : b->wares) {
+					halt->add_ware_to_halt(j);
+				}
 			}
 			delete cargo[i];
 			cargo[i] = NULL;
@@ -2657,6 +2917,7 @@ void haltestelle_t::transfer_goods(halthandle_t halt)
 // private helper function for recalc_station_type()
 void haltestelle_t::add_to_station_type( grund_t *gr )
 {
+	invalidate_route_cache();
 	// init in any case ...
 	if(  tiles.empty()  ) {
 		capacity[0] = 0;
@@ -2762,6 +3023,7 @@ void haltestelle_t::add_to_station_type( grund_t *gr )
  */
 void haltestelle_t::recalc_station_type()
 {
+	invalidate_route_cache();
 	capacity[0] = 0;
 	capacity[1] = 0;
 	capacity[2] = 0;
@@ -2875,20 +3137,21 @@ void haltestelle_t::rdwr(loadsave_t *file)
 	if(file->is_saving()) {
 		const char *s;
 		for(unsigned i=0; i<goods_manager_t::get_max_catg_index(); i++) {
-			vector_tpl<ware_t> *warray = cargo[i];
-			if(warray) {
+			if(cargo[i]) {
 				s = "y"; // needs to be non-empty
 				file->rdwr_str(s);
 				if(  file->is_version_less(112, 3)  ) {
-					uint16 count = warray->get_count();
+					uint16 count = cargo[i]->get_count();
 					file->rdwr_short(count);
 				}
 				else {
-					uint32 count = warray->get_count();
+					uint32 count = cargo[i]->get_count();
 					file->rdwr_long(count);
 				}
-				for(ware_t & ware : *warray) {
-					ware.rdwr(file);
+				for(halt_cargo_t::bucket_t * b : cargo[i]->get_buckets()) {
+					for(ware_t & ware : b->wares) {
+						ware.rdwr(file);
+					}
 				}
 			}
 		}
@@ -2965,33 +3228,47 @@ void haltestelle_t::rdwr(loadsave_t *file)
 
 
 
-void haltestelle_t::finish_rd()
+void haltestelle_t::finish_rd_cargo()
 {
-	verbinde_fabriken();
-
-	stale_convois.clear();
-	stale_lines.clear();
 	// fix good destination coordinates
 	for(unsigned i=0; i<goods_manager_t::get_max_catg_index(); i++) {
 		if(cargo[i]) {
-			vector_tpl<ware_t> * warray = cargo[i];
-			for(ware_t & j : *warray) {
+			// old games may change the via halt, so sort into new buckets
+			vector_tpl<ware_t> all_wares;
+			cargo[i]->get_all( all_wares );
+			delete cargo[i];
+			cargo[i] = new halt_cargo_t();
+			for(ware_t & j : all_wares) {
 				j.finish_rd(welt);
+				cargo[i]->append( j );
 			}
-			// merge identical entries (should only happen with old games)
-			for(unsigned j=0; j<warray->get_count(); j++) {
-				if(  (*warray)[j].amount==0  ) {
-					continue;
-				}
-				for(unsigned k=j+1; k<warray->get_count(); k++) {
-					if(  (*warray)[k].amount>0  &&  (*warray)[j].same_destination( (*warray)[k] )  ) {
-						(*warray)[j].amount += (*warray)[k].amount;
-						(*warray)[k].amount = 0;
+			for(halt_cargo_t::bucket_t * b : cargo[i]->get_buckets()) {
+				vector_tpl<ware_t> &warray = b->wares;
+				// merge identical entries (should only happen with old games)
+				for(unsigned j=0; j<warray.get_count(); j++) {
+					if(  warray[j].amount==0  ) {
+						continue;
+					}
+					for(unsigned k=j+1; k<warray.get_count(); k++) {
+						if(  warray[k].amount>0  &&  warray[j].same_destination( warray[k] )  ) {
+							warray[j].amount += warray[k].amount;
+							warray[k].amount = 0;
+						}
 					}
 				}
 			}
+			cargo[i]->compact();
 		}
 	}
+}
+
+
+void haltestelle_t::finish_rd()
+{
+	verbinde_fabriken();
+
+	stale_convois.clear();
+	stale_lines.clear();
 
 	// handle name for old stations which don't exist in kartenboden
 	// also recover from stations without tiles (from broken savegames)
@@ -3081,6 +3358,8 @@ void haltestelle_t::recalc_status()
 	// since the status is ordered ...
 	uint8 status_bits = 0;
 
+	uint8 old_overcrowded[lengthof(overcrowded)];
+	memcpy( old_overcrowded, overcrowded, sizeof(overcrowded) );
 	MEMZERO(overcrowded);
 
 	uint64 total_sum = 0;
@@ -3138,6 +3417,11 @@ void haltestelle_t::recalc_status()
 	}
 
 	financial_history[0][HALT_WAITING] = total_sum;
+
+	if(  memcmp( old_overcrowded, overcrowded, sizeof(overcrowded) ) != 0  ) {
+		// routes avoiding overcrowded stops may change
+		invalidate_route_cache();
+	}
 }
 
 
@@ -53,8 +53,54 @@ class loadsave_t;
 class schedule_t;
 class player_t;
 class ware_t;
+class freight_summary_t;
 template<class T> class bucket_heap_tpl;
 
+
+/**
+ * Waiting goods of one category at a stop, grouped by their next transfer stop (via halt).
+ * Thus loading for a certain next stop only looks at the goods going there.
+ * All packets of a bucket have the via halt of the bucket.
+ */
+class halt_cargo_t
+{
+public:
+	struct bucket_t
+	{
+		halthandle_t via;
+		vector_tpl<ware_t> wares;
+	};
+
+private:
+	vector_tpl<bucket_t *> buckets;
+
+	halt_cargo_t(const halt_cargo_t &);
+	halt_cargo_t& operator=(const halt_cargo_t &);
+
+public:
+	halt_cargo_t() {}
+	~halt_cargo_t();
+
+	vector_tpl<bucket_t *> const& get_buckets() const { return buckets; }
+
+	/// @returns the goods waiting for the next stop @p via or NULL
+	vector_tpl<ware_t> *get(halthandle_t via) const;
+
+	/// adds the packet to the bucket of its via halt
+	void append(const ware_t &ware);
+
+	/// number of packets
+	uint32 get_count() const;
+
+	bool empty() const { return get_count() == 0; }
+
+	/// removes all packets without amount and all empty buckets
+	void compact();
+
+	/// copies all packets into @p list
+	void get_all(vector_tpl<ware_t> &list) const;
+};
+
 // -------------------------- Haltestelle ----------------------------
 
 /**
@@ -303,7 +349,7 @@ private:
 
 
 	// Array with different categories that contains all waiting goods at this stop
-	vector_tpl<ware_t> **cargo;
+	halt_cargo_t **cargo;
 
 	/**
 	 * Liste der angeschlossenen Fabriken
@@ -336,6 +382,12 @@ private:
 	 */
 	bool vereinige_waren(const ware_t &ware);
 
+	/**
+	 * Joins arriving goods with waiting goods of the same destination for any next stop,
+	 * so they need no new route. The waiting goods take a newer next stop of @p ware.
+	 */
+	bool vereinige_waren_any_via(const ware_t &ware);
+
 	// add the ware to the internal storage, called only internally
 	void add_ware_to_halt(ware_t ware);
 
@@ -354,6 +406,12 @@ private:
 	*/
 	uint8 old_sort_mode;
 
+	/// only amounts of waiting packets changed since the freight list was built
+	bool freight_amounts_changed;
+
+	/// rows of the freight list, created when it is shown the first time
+	freight_summary_t *freight_summary;
+
 	haltestelle_t(loadsave_t *file);
 	haltestelle_t(koord pos, player_t *player);
 	~haltestelle_t();
@@ -511,6 +569,17 @@ public:
 	 */
 	static int search_route( const halthandle_t *const start_halts, const uint16 start_halt_count, const bool no_routing_over_overcrowding, ware_t &ware, ware_t *const return_ware=NULL );
 
+	/**
+	 * Same as search_route(), but remembers the result for the same start halts and
+	 * the same halts at the target tile. Thus the many packets of a city, which mostly
+	 * travel between the same stops, need only one search. The results are forgotten,
+	 * when any stop becomes overcrowded or is no longer overcrowded.
+	 */
+	static int search_route_batched( const halthandle_t *const start_halts, const uint16 start_halt_count, const bool no_routing_over_overcrowding, ware_t &ware, ware_t *const return_ware=NULL );
+
+	/// forget all results of search_route_batched(); needed after any change of connections or enabled goods
+	static void invalidate_route_cache();
+
 	/**
 	 * A separate version of route searching code for re-calculating routes
 	 * Search is resumable, that is if called for the same halt and same goods category
@@ -705,6 +774,12 @@ public:
 
 	void rdwr(loadsave_t *file);
 
+	/**
+	 * Sorts the loaded goods into their buckets. Independent of other halts,
+	 * so it runs in parallel for all halts before finish_rd().
+	 */
+	void finish_rd_cargo();
+
 	void finish_rd();
 
 	/**
@@ -44,6 +44,7 @@
 #include "siminteraction.h"
 #include "simtypes.h"
 #include "simachievements.h"
+#include "simbenchmark.h"
 
 #include "sys/simsys.h"
 #include "display/simgraph.h"
@@ -75,6 +76,7 @@
 #include "dataobj/loadsave.h"
 #include "dataobj/environment.h"
 #include "dataobj/tabfile.h"
+#include "dataobj/freelist.h"
 #include "dataobj/scenario.h"
 #include "dataobj/settings.h"
 #include "dataobj/translator.h"
@@ -88,6 +90,7 @@
 #include "sound/sound.h"
 
 #include "utils/cbuffer.h"
+#include "utils/profiler.h"
 #include "utils/simrandom.h"
 #include "utils/unicode.h"
 
@@ -146,111 +149,6 @@ static void show_sizes()
 #endif
 
 
-#if defined DEBUG || defined PROFILE
-// render tests ...
-static void show_times(karte_t *welt, main_view_t *view)
-{
-	intr_set_view(view);
-	welt->set_fast_forward(true);
-	intr_disable();
-
-	dbg->message( "show_times()", "simple profiling of drawing routines" );
-	int i;
-
-	image_id img = ground_desc_t::outside->get_image(0,0);
-
-	display_color_img(img, 120, 100, 1, 0, 1);
-	uint32 ms = dr_time();
-	for (i = 0;  i < 6000000;  i++) {
-		display_img_aux( img, 50, 50, 1, 0, true  CLIP_NUM_DEFAULT);
-	}
-	dbg->message("show_times()", "display_img() %i iterations took %li ms", i, dr_time() - ms );
-
-	image_id player_img = skinverwaltung_t::color_options->get_image_id(0);
-	ms = dr_time();
-	for (i = 0;  i < 1000000;  i++) {
-		display_color_img( player_img, 120, 100, i%15, 0, 1);
-	}
-	dbg->message("show_times()", "display_color_img() with recolor %i iterations took %li ms", i, dr_time() - ms );
-
-	ms = dr_time();
-	for (i = 0;  i < 100000;  i++) {
-		display_color_img( img, 120, 100, 0, 1, 1);
-		display_color_img( player_img, 160, 150, 16, 1, 1);
-	}
-	dbg->message("show_times()", "display_color_img() 3x %i iterations took %li ms", i, dr_time() - ms );
-
-#if !defined(MULTI_THREAD)
-	ms = dr_time();
-	for (i = 0;  i < 600000;  i++) {
-		dr_prepare_flush();
-		dr_flush();
-	}
-	dbg->message("show_times()", "display_flush_buffer() %i iterations took %li ms", i, dr_time() - ms );
-#endif
-
-	ms = dr_time();
-	for (i = 0;  i < 300000;  i++) {
-		display_text_proportional_len_clip_rgb(100, 120, "Dies ist ein kurzer Textetxt ...", 0, 0, false, -1);
-	}
-	dbg->message("show_times()", "display_text_proportional_len_clip_rgb() %i iterations took %li ms", i, dr_time() - ms );
-
-	ms = dr_time();
-	for (i = 0;  i < 300000;  i++) {
-		display_fillbox_wh_rgb(100, 120, 300, 50, 0, false);
-	}
-	dbg->message("show_times()", "display_fillbox_wh_rgb() %i iterations took %li ms", i, dr_time() - ms );
-
-	ms = dr_time();
-	for (i = 0; i < 2000; i++) {
-		view->display(true);
-	}
-	dbg->message("show_times()", "view->display(true) %i iterations took %li ms", i, dr_time() - ms );
-
-	ms = dr_time();
-	for (i = 0; i < 2000; i++) {
-		view->display(true);
-		win_display_flush(0.0);
-	}
-	dbg->message("show_times()", "view->display(true) and flush %i iterations took %li ms", i, dr_time() - ms );
-
-	ms = dr_time();
-	for (i = 0; i < 40000000/(int)weg_t::get_alle_wege().get_count(); i++) {
-		for(weg_t * const w : weg_t::get_alle_wege() ) {
-			grund_t *dummy;
-			welt->lookup( w->get_pos() )->get_neighbour( dummy, invalid_wt, ribi_t::north );
-		}
-	}
-	dbg->message("show_times()", "grund_t::get_neighbour() %i iterations took %li ms", i*weg_t::get_alle_wege().get_count(), dr_time() - ms );
-
-	ms = dr_time();
-	for (i = 0; i < 1000; i++) {
-		welt->sync_step(100);
-		welt->sync_step(100);
-		welt->sync_step(100);
-		welt->sync_step(100);
-		welt->sync_step(100);
-		welt->sync_step(100);
-		welt->sync_step(100);
-		welt->sync_step(100);
-		welt->sync_step(100);
-		welt->sync_step(100);
-		welt->display(1000);
-		welt->step();
-	}
-	dbg->message("show_times()", "welt->sync_step(200)*10/display(1000)/step %i iterations took %li ms", i, dr_time() - ms);
-
-	ms = dr_time();
-	for (i = 0; i < 2000; i++) {
-		welt->sync_step(200);
-		welt->display(200);
-		welt->step();
-	}
-	dbg->message("show_times()", "welt->sync_step(200)/display(200)/step %i iterations took %li ms", i, dr_time() - ms );
-}
-#endif
-
-
 // some routines for the modal display
 static bool never_quit() { return false; }
 static bool no_language() { return translator::get_language()!=-1; }
@@ -386,6 +284,9 @@ void print_help()
 		"command line parameters available: \n"
 		" -addons             loads also addons (with -objects)\n"
 		" -async              asynchronous images, only for SDL\n"
+		" -baseline FILE      compare the -benchmark results with those in FILE\n"
+		" -benchmark NAME [SUITE] loads savegame 'NAME', runs the benchmark scenarios\n"
+		"                     (all, render, sim, map, io or one scenario) and quits\n"
 		" -borderless         emulate fullscreen as borderless window\n"
 		" -use_hw             hardware double buffering, only for SDL\n"
 		" -debug NUM          enables debugging (1..5) Append p to show pak details\n"
@@ -403,6 +304,7 @@ void print_help()
 		" -tag TAG            sets syslog tag (default 'simutrans')\n"
 #endif
 		" -mute               mute all sounds\n"
+		" -no_bulk_alloc      allocates loaded objects in small chunks (to compare with -benchmark)\n"
 		" -noaddons           does not load any addon (default)\n"
 		" -nomidi             turns off background music\n"
 		" -nosound            turns off ambient sounds\n"
@@ -410,6 +312,7 @@ void print_help()
 		" -set_pakdir DIR     loads the pakset in specified directory\n"
 		" -pause              starts game with paused after loading\n"
 		"                     a server will pause if there are no clients\n"
+		" -profile            profile the main loop, trace is written on quit\n"
 		" -res N              starts in specified resolution: \n"
 		"                      1=640x480, 2=800x600, 3=1024x768, 4=1280x1024\n"
 		" -scenario NAME      Load scenario NAME\n"
@@ -427,6 +330,8 @@ void print_help()
 		" -set_basedir WD     Use WD as directory containing all constant data.\n"
 		" -set_installdir WD  Use WD as directory for pakset download.\n"
 		" -set_userdir WD     Use WD as directory for local user data.\n"
+		" -simulate MONTHS    runs the loaded game MONTHS without display as fast as\n"
+		"                     possible, prints months per second and gamestate hash\n"
 		" -singleuser         Save everything in data directory (portable version)\n"
 #ifdef DEBUG
 		" -sizes              Show current size of some structures\n"
@@ -437,9 +342,6 @@ void print_help()
 		" -threads N          use N threads if possible\n"
 #endif
 		" -timeline           enables timeline\n"
-#if defined DEBUG || defined PROFILE
-		" -times              does some simple profiling\n"
-#endif
 		" -until YEAR.MONTH   quits when MONTH of YEAR starts\n"
 	);
 }
@@ -743,7 +645,11 @@ int simu_main(int argc, char** argv)
 	}
 
 	if(  env_t::pak_name.empty()  ) {
-		if(  const char *filename = args.gimme_arg("-load", 1)  ) {
+		const char *filename = args.gimme_arg("-load", 1);
+		if(  filename == NULL  ) {
+			filename = args.gimme_arg("-benchmark", 1);
+		}
+		if(  filename  ) {
 			// try to get a pak file path from a savegame file
 			// read pak_extension from file
 			loadsave_t test;
@@ -1278,13 +1184,17 @@ int simu_main(int argc, char** argv)
 		}
 	}
 
-	if(  args.has_arg("-load")  ) {
+	if(  args.has_arg("-no_bulk_alloc")  ) {
+		freelist_t::allow_bulk_mode( false );
+	}
+
+	if(  args.has_arg("-load")  ||  args.has_arg("-benchmark")  ) {
 		cbuffer_t buf;
 		dr_chdir( env_t::user_dir );
 		/**
 		 * Added automatic adding of extension
 		 */
-		const char *name = args.gimme_arg("-load", 1);
+		const char *name = args.has_arg("-load") ? args.gimme_arg("-load", 1) : args.gimme_arg("-benchmark", 1);
 		if (strstart(name, "net:")) {
 			buf.append( name );
 		}
@@ -1594,12 +1504,32 @@ int simu_main(int argc, char** argv)
 
 	uint32 quit_month = 0x7FFFFFFFu;
 
-#if defined DEBUG || defined PROFILE
-	// do a render test?
-	if (args.has_arg("-times")) {
-		show_times(welt, view);
+	int exit_code = EXIT_SUCCESS;
+	if(  args.has_arg("-benchmark")  ) {
+		const char *suite = args.gimme_arg("-benchmark", 2);
+		if(  suite == NULL  ||  suite[0] == '-'  ) {
+			suite = "all";
+		}
+		dr_chdir( env_t::user_dir );
+		if(  benchmark_t::run( welt, view, suite, loadgame.c_str(), args.gimme_arg("-baseline", 1) ) > 0  ) {
+			exit_code = EXIT_FAILURE;
+		}
+		env_t::quit_simutrans = true;
+	}
+
+	// pure simulation without display for throughput and determinism tests
+	if(  args.has_arg("-simulate")  ) {
+		const char *months_arg = args.gimme_arg("-simulate", 1);
+		const uint32 months = months_arg ? max( 1, atoi(months_arg) ) : 12;
+		const uint32 start_ms = dr_time();
+		const uint32 steps = welt->run_headless( months );
+		const uint32 ms = max( 1, (int)(dr_time() - start_ms) );
+		const uint32 hash = welt->get_gamestate_hash();
+		dbg->message( "simu_main()", "Simulated %u months (%u steps) in %u ms, gamestate hash %08x", months, steps, ms, hash );
+		printf( "{\"months\":%u,\"steps\":%u,\"wall_ms\":%u,\"months_per_second\":%.3f,\"gamestate_hash\":\"%08x\"}\n",
+			months, steps, ms, (months * 1000.0) / ms, hash );
+		env_t::quit_simutrans = true;
 	}
-#endif
 
 	// finish after a certain month? (must be entered decimal, i.e. 12*year+month
 	if(  args.has_arg("-until")  ) {
@@ -1614,6 +1544,10 @@ int simu_main(int argc, char** argv)
 		welt->set_fast_forward(true);
 	}
 
+	if(  args.has_arg("-profile")  ) {
+		profiler_t::set_enabled( true );
+	}
+
 	welt->reset_timer();
 	if(  !env_t::networkmode  &&  !env_t::server  ) {
 #ifdef display_in_main
@@ -1706,6 +1640,9 @@ int simu_main(int argc, char** argv)
 	// save settings
 	{
 		dr_chdir( env_t::user_dir );
+		if(  profiler_t::is_enabled()  ) {
+			profiler_t::write_chrome_trace( PROFILE_TRACE_FILE );
+		}
 		loadsave_t settings_file;
 		if(  settings_file.wr_open("settings.xml",loadsave_t::xml,0,"settings only/",SAVEGAME_VER_NR) == loadsave_t::FILE_STATUS_OK  ) {
 			env_t::rdwr(&settings_file);
@@ -1742,5 +1679,5 @@ int simu_main(int argc, char** argv)
 	steam_t::get_instance()->shutdown();
 #endif
 
-	return EXIT_SUCCESS;
+	return exit_code;
 }
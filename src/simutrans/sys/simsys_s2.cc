@@ -109,6 +109,8 @@ static SDL_Surface *screen;
 
 static int sync_blit = 0;
 static int use_dirty_tiles = 1;
+// something was uploaded to screen_tx since the last present (or the window needs a repaint)
+static bool screen_tx_changed = true;
 static sint16 fullscreen = WINDOWED;
 
 static SDL_Cursor *arrow;
@@ -524,6 +526,7 @@ int dr_textur_resize(unsigned short** const textur, int tex_w, int const tex_h)
 	}
 
 	*textur = dr_textur_init();
+	screen_tx_changed = true;
 
 	assert(tex_pitch <= screen->pitch / (int)sizeof(PIXVAL));
 	assert(tex_h <= screen->h);
@@ -570,8 +573,15 @@ void dr_flush()
 	display_flush_buffer();
 	if(  !use_dirty_tiles  ) {
 		SDL_UpdateTexture( screen_tx, NULL, screen->pixels, screen->pitch );
+		screen_tx_changed = true;
 	}
 
+	if(  !screen_tx_changed  ) {
+		// no dirty tiles uploaded, the window still shows the last frame
+		return;
+	}
+	screen_tx_changed = false;
+
 	SDL_Rect rSrc  = { 0, 0, display_get_width(), display_get_height()  };
 	SDL_RenderCopy( renderer, screen_tx, &rSrc, NULL );
 
@@ -588,6 +598,7 @@ void dr_textur(int xp, int yp, int w, int h)
 		r.w = xp + w > screen->w ? screen->w - xp : w;
 		r.h = yp + h > screen->h ? screen->h - yp : h;
 		SDL_UpdateTexture( screen_tx, &r, (uint8 *)screen->pixels + yp * screen->pitch + xp * sizeof(PIXVAL), screen->pitch );
+		screen_tx_changed = true;
 	}
 }
 static bool in_finger_handling = false;
@@ -703,6 +714,8 @@ static void internal_GetEvents()
 			break;
 
 		case SDL_WINDOWEVENT:
+			// exposed, restored, moved between displays ...: present the last frame again
+			screen_tx_changed = true;
 			if(  event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED  ) {
 				sys_event.new_window_size_w = max(1, SCREEN_TO_TEX_X(event.window.data1));
 				sys_event.new_window_size_h = max(1, SCREEN_TO_TEX_Y(event.window.data2));
@@ -0,0 +1,111 @@
+/*
+ * This file is part of the Simutrans project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#ifndef TPL_ALIAS_TABLE_TPL_H
+#define TPL_ALIAS_TABLE_TPL_H
+
+
+#include "../simtypes.h"
+#include "../utils/simrandom.h"
+#include "vector_tpl.h"
+#include "weighted_vector_tpl.h"
+
+
+/**
+ * Alias table (Walker's method) for a weighted_vector_tpl.
+ * After build(), a random element is picked in O(1) with two random numbers
+ * instead of the binary search of weighted_vector_tpl::at_weight().
+ * The table has to be rebuilt (O(n)) whenever the vector or its weights change,
+ * so it pays off for lists which are picked from much more often than changed.
+ */
+template<class T> class alias_table_tpl
+{
+private:
+	struct bucket_t
+	{
+		uint32 threshold; ///< random weight below this picks the bucket itself, else the alias
+		uint32 alias;
+	};
+
+	bucket_t *buckets;
+	uint32 cap;
+	uint32 count;
+	uint32 total_weight;
+	bool valid;
+
+	alias_table_tpl(const alias_table_tpl &);
+	alias_table_tpl& operator=(const alias_table_tpl &);
+
+public:
+	alias_table_tpl() : buckets(NULL), cap(0), count(0), total_weight(0), valid(false) {}
+
+	~alias_table_tpl() { delete [] buckets; }
+
+	/// must be called after any change to the weighted vector
+	void invalidate() { valid = false; }
+
+	bool is_valid() const { return valid; }
+
+	/// (re)builds the table from the weights of @p wv
+	void build(const weighted_vector_tpl<T> &wv)
+	{
+		count = wv.get_count();
+		total_weight = wv.get_sum_weight();
+		valid = true;
+		if(  count > cap  ) {
+			delete [] buckets;
+			cap = count;
+			buckets = new bucket_t[cap];
+		}
+
+		// each bucket holds exactly total_weight, so the mass of an element is weight*count
+		// (integer arithmetic, so the resulting distribution is exactly the one of at_weight())
+		vector_tpl<uint64> mass(count);
+		vector_tpl<uint32> small, large;
+		for(  uint32 i = 0;  i < count;  i++  ) {
+			const uint32 weight = (i + 1 < count ? wv.weight_at(i + 1) : total_weight) - wv.weight_at(i);
+			mass.append( (uint64)weight * count );
+			if(  mass[i] < total_weight  ) {
+				small.append(i);
+			}
+			else {
+				large.append(i);
+			}
+		}
+
+		while(  !small.empty()  &&  !large.empty()  ) {
+			const uint32 s = small.pop_back();
+			const uint32 l = large.back();
+			buckets[s].threshold = (uint32)mass[s];
+			buckets[s].alias = l;
+			mass[l] -= total_weight - mass[s];
+			if(  mass[l] < total_weight  ) {
+				large.pop_back();
+				small.append(l);
+			}
+		}
+		// the rest fills its bucket completely
+		for(uint32 const i : large) {
+			buckets[i].threshold = total_weight;
+			buckets[i].alias = i;
+		}
+		for(uint32 const i : small) {
+			buckets[i].threshold = total_weight;
+			buckets[i].alias = i;
+		}
+	}
+
+	/// @returns random index into the weighted vector, table must be valid and total weight >0
+	uint32 pick_index() const
+	{
+		const bucket_t &b = buckets[simrand(count)];
+		return simrand(total_weight) < b.threshold ? (uint32)(&b - buckets) : b.alias;
+	}
+
+	/// @returns random element of @p wv, which must be the vector the table was built for
+	T const& pick(const weighted_vector_tpl<T> &wv) const { return wv[pick_index()]; }
+};
+
+#endif
@@ -11,6 +11,7 @@
 #include "../simmem.h"
 #include "../simdebug.h"
 #include "../simconst.h"
+#include "../dataobj/freelist.h"
 
 #ifdef MULTI_THREAD
 #include "../utils/simthread.h"
@@ -53,6 +54,13 @@ private:
 	// list of all allocated memory
 	nodelist_node_t* chunk_list;
 
+	// not yet used part of the newest chunk
+	char *bump_next;
+	char *bump_end;
+
+	// nodes per chunk in bulk mode (about 1 MB)
+	size_t bulk_chunk_size;
+
 #ifdef MULTI_THREAD
 	pthread_mutex_t freelist_mutex = PTHREAD_MUTEX_INITIALIZER;;
 #endif
@@ -61,10 +69,13 @@ public:
 	freelist_size_t(size_t size) :
 		freelist(0),
 		nodecount(0),
-		chunk_list(0)
+		chunk_list(0),
+		bump_next(0),
+		bump_end(0)
 	{
 		NODE_SIZE = (size + sizeof(nodelist_node_t) - sizeof(nodelist_node_t*));
 		new_chunk_size = ((32768 - sizeof(void*)) / NODE_SIZE);
+		bulk_chunk_size = ((1048576 - sizeof(void*)) / NODE_SIZE);
 		canary_free[3] = canary_used[3] = NODE_SIZE;
 	}
 
@@ -80,42 +91,46 @@ public:
 #endif
 		nodelist_node_t *tmp;
 		if (freelist == NULL) {
-			char* p = (char*)xmalloc(new_chunk_size*NODE_SIZE + sizeof(nodelist_node_t));
+			if (bump_next == bump_end) {
+				const size_t chunk_size = freelist_t::is_bulk_mode() ? bulk_chunk_size : new_chunk_size;
+				char* p = (char*)xmalloc(chunk_size*NODE_SIZE + sizeof(nodelist_node_t));
+				freelist_t::add_chunk(chunk_size*NODE_SIZE + sizeof(nodelist_node_t));
 
 #ifdef USE_VALGRIND_MEMCHECK
-			// tell valgrind that we still cannot access the pool p
-			VALGRIND_MAKE_MEM_NOACCESS(p, new_chunk_size*NODE_SIZE + sizeof(nodelist_node_t));
+				// tell valgrind that we still cannot access the pool p
+				VALGRIND_MAKE_MEM_NOACCESS(p, chunk_size*NODE_SIZE + sizeof(nodelist_node_t));
 #endif
-			// put the memory into the chunklist for free it
-			nodelist_node_t* chunk = (nodelist_node_t *)p;
+				// put the memory into the chunklist for free it
+				nodelist_node_t* chunk = (nodelist_node_t *)p;
 
-#ifdef USE_VALGRIND_MEMCHECK
-			// tell valgrind that we reserved space for one nodelist_node_t
-			VALGRIND_CREATE_MEMPOOL(chunk, 0, false);
-			VALGRIND_MEMPOOL_ALLOC(chunk, chunk, sizeof(*chunk));
-			VALGRIND_MAKE_MEM_UNDEFINED(chunk, sizeof(*chunk));
-#endif
-			chunk->next = chunk_list;
-			chunk_list = chunk;
-			p += sizeof(nodelist_node_t);
-			// then enter nodes into nodelist
-			for (size_t i = 0; i < new_chunk_size; i++) {
-				nodelist_node_t* tmp = (nodelist_node_t*)(p + i*NODE_SIZE);
 #ifdef USE_VALGRIND_MEMCHECK
 				// tell valgrind that we reserved space for one nodelist_node_t
-				VALGRIND_CREATE_MEMPOOL(tmp, 0, false);
-				VALGRIND_MEMPOOL_ALLOC(tmp, tmp, sizeof(*tmp));
-				VALGRIND_MAKE_MEM_UNDEFINED(tmp, sizeof(*tmp));
+				VALGRIND_CREATE_MEMPOOL(chunk, 0, false);
+				VALGRIND_MEMPOOL_ALLOC(chunk, chunk, sizeof(*chunk));
+				VALGRIND_MAKE_MEM_UNDEFINED(chunk, sizeof(*chunk));
+#endif
+				chunk->next = chunk_list;
+				chunk_list = chunk;
+				bump_next = p + sizeof(nodelist_node_t);
+				bump_end = bump_next + chunk_size*NODE_SIZE;
+			}
+			// nodes never used are handed out in memory order, so the chunk is only touched when needed
+			tmp = (nodelist_node_t*)bump_next;
+			bump_next += NODE_SIZE;
+#ifdef USE_VALGRIND_MEMCHECK
+			// tell valgrind that we reserved space for one nodelist_node_t
+			VALGRIND_CREATE_MEMPOOL(tmp, 0, false);
+			VALGRIND_MEMPOOL_ALLOC(tmp, tmp, sizeof(*tmp));
+			VALGRIND_MAKE_MEM_UNDEFINED(tmp, sizeof(*tmp));
 #endif
 #ifdef DEBUG_FREELIST
-				tmp->canary[0] = canary_free[0];
-				tmp->canary[1] = canary_free[1];
-				tmp->canary[2] = canary_free[2];
-				tmp->canary[3] = canary_free[3];
+			tmp->canary[0] = canary_free[0];
+			tmp->canary[1] = canary_free[1];
+			tmp->canary[2] = canary_free[2];
+			tmp->canary[3] = canary_free[3];
 #endif
-				tmp->next = freelist;
-				freelist = tmp;
-			}
+			tmp->next = NULL;
+			freelist = tmp;
 		}
 
 		// return first node of list
@@ -158,6 +173,7 @@ public:
 		}
 		freelist = 0;
 		nodecount = 0;
+		bump_next = bump_end = 0;
 	}
 
 	void putback_node(void* p)
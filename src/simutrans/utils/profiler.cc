@@ -0,0 +1,171 @@
+/*
+ * This file is part of the Simutrans project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+
+#include "profiler.h"
+#include "cbuffer.h"
+#include "../macros.h"
+#include "../simdebug.h"
+#include "../sys/simsys.h"
+
+
+/// number of samples kept for the trace (about 16 bytes each)
+#define PROFILE_TRACE_SIZE (1u << 18)
+
+/// length of the statistics interval
+#define PROFILE_INTERVAL_US (1000000u)
+
+
+struct trace_event_t
+{
+	uint64 start_us;
+	uint32 duration_us;
+	uint8 section;
+};
+
+
+bool profiler_t::enabled = false;
+
+static profiler_t::section_stats_t current_stats[PROFILE_MAX];
+static profiler_t::section_stats_t last_stats[PROFILE_MAX];
+static uint64 interval_start_us = 0;
+static uint64 last_interval_us = 0;
+
+static trace_event_t *trace = NULL;
+static uint32 trace_next = 0;
+static uint32 trace_count = 0;
+
+static const char *const section_names[PROFILE_MAX] = {
+	"step",
+	"new_month",
+	"convois",
+	"cities",
+	"factories",
+	"powernet",
+	"players",
+	"halts",
+	"routing",
+	"sync_step",
+	"sync_lists",
+	"display"
+};
+
+
+uint64 profiler_t::get_time_us()
+{
+	static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+	// +1, since 0 means not measured
+	return (uint64)std::chrono::duration_cast<std::chrono::microseconds>( std::chrono::steady_clock::now() - epoch ).count() + 1;
+}
+
+
+void profiler_t::set_enabled(bool on)
+{
+	if(  on  &&  !enabled  ) {
+		MEMZERO( current_stats );
+		MEMZERO( last_stats );
+		interval_start_us = get_time_us();
+		last_interval_us = 0;
+		if(  trace == NULL  ) {
+			trace = new trace_event_t[PROFILE_TRACE_SIZE];
+		}
+		trace_next = 0;
+		trace_count = 0;
+	}
+	enabled = on;
+}
+
+
+void profiler_t::add_sample(profile_section_t section, uint64 start_us, uint64 end_us)
+{
+	const uint32 duration = (uint32)(end_us - start_us);
+
+	if(  end_us - interval_start_us >= PROFILE_INTERVAL_US  ) {
+		// new interval
+		memcpy( last_stats, current_stats, sizeof(last_stats) );
+		MEMZERO( current_stats );
+		last_interval_us = end_us - interval_start_us;
+		interval_start_us = end_us;
+	}
+
+	section_stats_t &s = current_stats[section];
+	s.calls ++;
+	s.total_us += duration;
+	if(  duration > s.max_us  ) {
+		s.max_us = duration;
+	}
+
+	trace_event_t &e = trace[trace_next];
+	e.start_us = start_us;
+	e.duration_us = duration;
+	e.section = section;
+	trace_next = (trace_next + 1) & (PROFILE_TRACE_SIZE - 1);
+	if(  trace_count < PROFILE_TRACE_SIZE  ) {
+		trace_count ++;
+	}
+}
+
+
+const profiler_t::section_stats_t &profiler_t::get_last_stats(profile_section_t section)
+{
+	return last_stats[section];
+}
+
+
+uint64 profiler_t::get_last_interval_us()
+{
+	return last_interval_us;
+}
+
+
+const char *profiler_t::get_section_name(profile_section_t section)
+{
+	return section < PROFILE_MAX ? section_names[section] : "?";
+}
+
+
+void profiler_t::print_summary(cbuffer_t &buf)
+{
+	if(  !enabled  ) {
+		buf.append( "Profiler is off.\n" );
+		return;
+	}
+	buf.printf( "%-12s %8s %10s %8s %6s\n", "section", "calls/s", "total us", "max us", "load" );
+	for(  int i = 0;  i < PROFILE_MAX;  i++  ) {
+		const section_stats_t &s = last_stats[i];
+		const uint32 load = last_interval_us ? (uint32)((s.total_us * 1000) / last_interval_us) : 0;
+		buf.printf( "%-12s %8u %10u %8u %3u.%u%%\n", section_names[i], s.calls, (uint32)s.total_us, s.max_us, load / 10, load % 10 );
+	}
+}
+
+
+bool profiler_t::write_chrome_trace(const char *filename)
+{
+	if(  trace == NULL  ) {
+		return false;
+	}
+
+	FILE *f = dr_fopen( filename, "w" );
+	if(  f == NULL  ) {
+		dbg->warning( "profiler_t::write_chrome_trace()", "Cannot write '%s'", filename );
+		return false;
+	}
+
+	fprintf( f, "{\"traceEvents\":[\n" );
+	const uint32 first = (trace_next + PROFILE_TRACE_SIZE - trace_count) & (PROFILE_TRACE_SIZE - 1);
+	for(  uint32 i = 0;  i < trace_count;  i++  ) {
+		const trace_event_t &e = trace[ (first + i) & (PROFILE_TRACE_SIZE - 1) ];
+		fprintf( f, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%llu,\"dur\":%u}\n",
+			i ? "," : "", section_names[e.section], (unsigned long long)e.start_us, e.duration_us );
+	}
+	fprintf( f, "],\"displayTimeUnit\":\"ms\"}\n" );
+	fclose( f );
+
+	dbg->message( "profiler_t::write_chrome_trace()", "%u samples written to '%s'", trace_count, filename );
+	return true;
+}
@@ -0,0 +1,108 @@
+/*
+ * This file is part of the Simutrans project under the Artistic License.
+ * (see LICENSE.txt)
+ */
+
+#ifndef UTILS_PROFILER_H
+#define UTILS_PROFILER_H
+
+
+#include "../simtypes.h"
+
+class cbuffer_t;
+
+/// default file name for the trace (relative to the user directory)
+#define PROFILE_TRACE_FILE "profile-trace.json"
+
+
+/// subsystems measured by the profiler
+enum profile_section_t
+{
+	PROFILE_STEP = 0,
+	PROFILE_NEW_MONTH,
+	PROFILE_CONVOIS,
+	PROFILE_CITIES,
+	PROFILE_FACTORIES,
+	PROFILE_POWERNET,
+	PROFILE_PLAYERS,
+	PROFILE_HALTS,
+	PROFILE_ROUTING,
+	PROFILE_SYNC_STEP,
+	PROFILE_SYNC_LISTS,
+	PROFILE_DISPLAY,
+	PROFILE_MAX
+};
+
+
+/**
+ * Low overhead profiler for the main loop.
+ * When disabled, a profile_scope_t costs only the test of a flag.
+ * When enabled, calls and time of each section are summed up per second of wall time
+ * and every single call is kept in a ring buffer, which can be written as a
+ * Chrome trace (chrome://tracing or https://ui.perfetto.dev).
+ * Must be only used from the main thread.
+ */
+class profiler_t
+{
+public:
+	struct section_stats_t
+	{
+		uint32 calls;
+		uint32 max_us;
+		uint64 total_us;
+	};
+
+private:
+	static bool enabled;
+
+	/// microseconds since start of the profiler
+	static uint64 get_time_us();
+
+	friend class profile_scope_t;
+
+public:
+	static bool is_enabled() { return enabled; }
+
+	/// (de)activates the profiler, activating clears all samples
+	static void set_enabled(bool on);
+
+	/// adds a sample for the section, times from get_time_us()
+	static void add_sample(profile_section_t section, uint64 start_us, uint64 end_us);
+
+	/// statistics of the last completed interval (about one second)
+	static const section_stats_t &get_last_stats(profile_section_t section);
+
+	/// length of the last completed interval in microseconds
+	static uint64 get_last_interval_us();
+
+	static const char *get_section_name(profile_section_t section);
+
+	/// print the last interval as table
+	static void print_summary(cbuffer_t &buf);
+
+	/// writes all samples in the ring buffer as Chrome trace JSON
+	static bool write_chrome_trace(const char *filename);
+};
+
+
+/**
+ * Measures the time from construction to destruction, e.g.
+ * { profile_scope_t const p(PROFILE_CITIES); ... }
+ */
+class profile_scope_t
+{
+	const profile_section_t section;
+	const uint64 start_us; // 0 if not measuring
+
+public:
+	explicit profile_scope_t(profile_section_t s) : section(s), start_us( profiler_t::enabled ? profiler_t::get_time_us() : 0 ) {}
+
+	~profile_scope_t()
+	{
+		if(  start_us  &&  profiler_t::enabled  ) {
+			profiler_t::add_sample( section, start_us, profiler_t::get_time_us() );
+		}
+	}
+};
+
+#endif
@@ -21,6 +21,7 @@
 /* from now on rail vehicles (and other vehicles using blocks) */
 rail_vehicle_t::rail_vehicle_t(loadsave_t *file, bool is_first, bool is_last) : vehicle_t()
 {
+	failed_reservation.valid = false;
 	vehicle_t::rdwr_from_convoi(file);
 
 	if(  file->is_loading()  ) {
@@ -66,6 +67,7 @@ rail_vehicle_t::rail_vehicle_t(koord3d pos, const vehicle_desc_t* desc, player_t
 	vehicle_t(pos, desc, player)
 {
 	cnv = cn;
+	failed_reservation.valid = false;
 }
 
 
@@ -93,6 +95,7 @@ void rail_vehicle_t::set_convoi(convoi_t *c)
 {
 	if(c!=cnv) {
 		DBG_MESSAGE("rail_vehicle_t::set_convoi()","new=%p old=%p",c,cnv);
+		failed_reservation.valid = false;
 		if(leading) {
 			if(cnv!=NULL  &&  cnv!=(convoi_t *)1) {
 				// free route from old convoi
@@ -702,6 +705,31 @@ bool rail_vehicle_t::can_enter_tile(const grund_t *gr, sint32 &restart_speed, ui
 }
 
 
+bool rail_vehicle_t::is_reservation_still_failing(const route_t *route, route_t::index_t start_index, int count) const
+{
+	const failed_reservation_t &f = failed_reservation;
+	if(  !f.valid  ||  f.start_index!=start_index  ||  f.count!=count  ||  f.route_version!=route->get_version()
+		||  f.track_version!=schiene_t::track_version  ||  f.reservation_count!=cnv->get_reservation_count()  ) {
+		return false;
+	}
+	// same route and same blocks => fails again, if the tile is still reserved by someone else
+	const grund_t *gr = welt->lookup(route->at(f.blocked_index));
+	const schiene_t *sch1 = gr ? (const schiene_t *)gr->get_weg(get_waytype()) : NULL;
+	if(  sch1==NULL  ) {
+		return false;
+	}
+	if(  !sch1->can_reserve(cnv->self)  ) {
+		return true;
+	}
+	if(  gr->has_two_ways()  ) {
+		if(  const schiene_t* sch0 = dynamic_cast<const schiene_t*>(gr->get_weg_nr(gr->get_weg_nr(0) == sch1))  ) {
+			return !sch0->can_reserve(cnv->self);
+		}
+	}
+	return false;
+}
+
+
 /**
  * reserves or un-reserves all blocks and returns the handle to the next block (if there)
  * if count is larger than 1, (and defined) maximum MAX_CHOOSE_BLOCK_TILES tiles will be checked
@@ -726,11 +754,20 @@ bool rail_vehicle_t::block_reserver(const route_t *route, route_t::index_t start
 		start_index++;
 	}
 
+	if(  reserve  &&  is_reservation_still_failing( route, start_index, count )  ) {
+		// waiting in front of the same occupied tile => no need to walk the block again
+		next_signal_index = failed_reservation.next_signal_index;
+		next_crossing_index = failed_reservation.next_crossing_index;
+		cnv->set_next_reservation_index( start_index );
+		return false;
+	}
+
 	if(  !reserve  ) {
 		cnv->set_next_reservation_index( start_index );
 	}
 
 	// find next block segment en route
+	const int count_at_start = count;
 	route_t::index_t i = start_index;
 	next_signal_index = route_t::INVALID_INDEX;
 	next_crossing_index = route_t::INVALID_INDEX;
@@ -825,6 +862,17 @@ bool rail_vehicle_t::block_reserver(const route_t *route, route_t::index_t start
 			}
 		}
 		cnv->set_next_reservation_index( start_index );
+
+		// the loop stopped after the occupied tile
+		failed_reservation.valid = true;
+		failed_reservation.count = count_at_start;
+		failed_reservation.route_version = route->get_version();
+		failed_reservation.track_version = schiene_t::track_version;
+		failed_reservation.reservation_count = cnv->get_reservation_count();
+		failed_reservation.start_index = start_index;
+		failed_reservation.blocked_index = i-1;
+		failed_reservation.next_signal_index = next_signal_index;
+		failed_reservation.next_crossing_index = next_crossing_index;
 		return false;
 	}
 
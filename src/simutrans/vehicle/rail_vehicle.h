@@ -17,6 +17,28 @@
  */
 class rail_vehicle_t : public vehicle_t
 {
+	/**
+	 * The last call of block_reserver(), which failed at a tile reserved by another convoi.
+	 * As long as this tile stays reserved and neither the route, the tracks nor the reservations
+	 * of our convoi changed, the same call fails again. Hence a train waiting at a signal
+	 * checks a single tile instead of the whole block when it retries.
+	 */
+	struct failed_reservation_t {
+		bool valid;
+		int count;
+		uint32 route_version;
+		uint32 track_version;
+		uint32 reservation_count;
+		route_t::index_t start_index;
+		route_t::index_t blocked_index;
+		route_t::index_t next_signal_index;
+		route_t::index_t next_crossing_index;
+	};
+	mutable failed_reservation_t failed_reservation;
+
+	/// true, if block_reserver() would fail as at its last failed call
+	bool is_reservation_still_failing(const route_t *route, route_t::index_t start_index, int count) const;
+
 protected:
 	bool check_next_tile(const grund_t *bd) const OVERRIDE;
 
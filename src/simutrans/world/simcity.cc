@@ -1905,7 +1905,7 @@ void stadt_t::step_passagiere()
 			ware_t return_pax(wtyp);
 
 			// now, finally search a route; this consumes most of the time
-			int const route_result = haltestelle_t::search_route( &start_halts[0], start_halts.get_count(), welt->get_settings().is_no_routing_over_overcrowding(), pax, &return_pax);
+			int const route_result = haltestelle_t::search_route_batched( &start_halts[0], start_halts.get_count(), welt->get_settings().is_no_routing_over_overcrowding(), pax, &return_pax);
 			halthandle_t start_halt = return_pax.get_target_halt();
 
 			if(  route_result==haltestelle_t::ROUTE_OK  ) {
@@ -2178,12 +2178,14 @@ void stadt_t::add_target_city(stadt_t *const city)
 		city,
 		weight_by_distance( city->get_einwohner()+1, shortest_distance( get_center(), city->get_center() ) )
 	);
+	target_cities_alias.invalidate();
 }
 
 
 void stadt_t::recalc_target_cities()
 {
 	target_cities.clear();
+	target_cities_alias.invalidate();
 	for(stadt_t* const c : welt->get_cities()) {
 		add_target_city(c);
 	}
@@ -2197,12 +2199,14 @@ void stadt_t::add_target_attraction(gebaeude_t *const attraction)
 		attraction,
 		weight_by_distance( attraction->get_passagier_level() << 4, shortest_distance( get_center(), attraction->get_pos().get_2d() ) )
 	);
+	target_attractions_alias.invalidate();
 }
 
 
 void stadt_t::recalc_target_attractions()
 {
 	target_attractions.clear();
+	target_attractions_alias.invalidate();
 	for(gebaeude_t* const a : welt->get_attractions()) {
 		add_target_attraction(a);
 	}
@@ -2228,7 +2232,10 @@ koord stadt_t::find_destination(factory_set_t &target_factories, const sint64 ge
 	const sint16 rand = simrand(100 - (target_factories.generation_ratio >> RATIO_BITS));
 	if(  rand < welt->get_settings().get_tourist_percentage()  &&  target_attractions.get_sum_weight() > 0  ) {
 		*will_return = tourist_return; // tourists will return
-		gebaeude_t *const &attraction = pick_any_weighted(target_attractions);
+		if(  !target_attractions_alias.is_valid()  ) {
+			target_attractions_alias.build( target_attractions );
+		}
+		gebaeude_t *const &attraction = target_attractions_alias.pick( target_attractions );
 		dest_city = attraction->get_stadt(); // unsure if return value always valid
 		if (dest_city == NULL) {
 			// if destination city was invalid assume this city is the source
@@ -2240,7 +2247,10 @@ koord stadt_t::find_destination(factory_set_t &target_factories, const sint64 ge
 	// generate general traffic between buildings
 
 	// since the locality is already taken into account for us, we just use the random weight
-	stadt_t *const selected_city = pick_any_weighted( target_cities );
+	if(  !target_cities_alias.is_valid()  ) {
+		target_cities_alias.build( target_cities );
+	}
+	stadt_t *const selected_city = target_cities_alias.pick( target_cities );
 	// no return trip if the destination is inside the same city
 	*will_return = selected_city == this ? no_return : city_return;
 	dest_city = selected_city;
@@ -12,6 +12,7 @@
 
 #include "../tpl/vector_tpl.h"
 #include "../tpl/weighted_vector_tpl.h"
+#include "../tpl/alias_table_tpl.h"
 #include "../tpl/sparse_tpl.h"
 #include "../utils/plainstring.h"
 
@@ -352,6 +353,7 @@ private:
 	 */
 	void step_grow_city(bool new_town = false);
 
+public:
 	enum pax_return_type {
 		no_return,
 		factory_return,
@@ -359,6 +361,8 @@ private:
 		city_return
 	};
 
+private:
+
 	/**
 	 * verteilt die Passagiere auf die Haltestellen
 	 */
@@ -574,19 +578,25 @@ private:
 	 */
 	weighted_vector_tpl<gebaeude_t *> target_attractions;
 
+	/**
+	 * For O(1) random picks from the lists above, rebuilt on first pick after a change
+	 */
+	alias_table_tpl<stadt_t *> target_cities_alias;
+	alias_table_tpl<gebaeude_t *> target_attractions_alias;
+
 public:
 	/**
 	 * Functions for manipulating the list of target cities
 	 */
 	void add_target_city(stadt_t *const city);
-	void remove_target_city(stadt_t *const city) { target_cities.remove( city ); }
+	void remove_target_city(stadt_t *const city) { target_cities.remove( city ); target_cities_alias.invalidate(); }
 	void recalc_target_cities();
 
 	/**
 	 * Functions for manipulating the list of target attractions
 	 */
 	void add_target_attraction(gebaeude_t *const attraction);
-	void remove_target_attraction(gebaeude_t *const attraction) { target_attractions.remove( attraction ); }
+	void remove_target_attraction(gebaeude_t *const attraction) { target_attractions.remove( attraction ); target_attractions_alias.invalidate(); }
 	void recalc_target_attractions();
 
 	/**
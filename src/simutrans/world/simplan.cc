@@ -340,6 +340,14 @@ void planquadrat_t::check_season_snowline(const bool season_change, const bool s
 }
 
 
+void planquadrat_t::check_snowline() const
+{
+	for(  uint8 i = 0;  i < ground_size;  i++  ) {
+		get_boden_bei(i)->check_snowline();
+	}
+}
+
+
 void planquadrat_t::correct_water()
 {
 	grund_t *gr = get_kartenboden();
@@ -20,6 +20,15 @@
 #endif
 #endif
 
+/**
+ * The map tiles are stored in square blocks of 2^PLAN_BLOCK_BITS tiles edge length,
+ * i.e. 8x8 tiles by default. 0 gives the old row by row layout.
+ */
+#if !defined(PLAN_BLOCK_BITS)
+#define PLAN_BLOCK_BITS 3
+#endif
+#define PLAN_BLOCK_MASK ((1u << PLAN_BLOCK_BITS) - 1)
+
 class karte_ptr_t;
 class grund_t;
 class obj_t;
@@ -236,6 +245,11 @@ public:
 	*/
 	void check_season_snowline(const bool season_change, const bool snowline_change);
 
+	/**
+	 * Updates only snowline dependent graphics, can be called from world_xy_loop
+	 */
+	void check_snowline() const;
+
 	void display_obj(const sint16 xpos, const sint16 ypos, const sint16 raster_tile_width, const bool is_global, const sint8 hmin, const sint8 hmax  CLIP_NUM_DEF) const;
 
 	void display_overlay(sint16 xpos, sint16 ypos) const;
@@ -89,8 +89,10 @@
 #include "../dataobj/powernet.h"
 #include "../dataobj/records.h"
 #include "../dataobj/pakset_manager.h"
+#include "../dataobj/freelist.h"
 
 #include "../utils/cbuffer.h"
+#include "../utils/profiler.h"
 #include "../utils/simrandom.h"
 #include "../utils/simstring.h"
 
@@ -273,6 +275,30 @@ void karte_t::world_xy_loop(xy_loop_func function, uint8 flags)
 }
 
 
+// the list for world_list_loop
+static list_loop_func list_loop_function;
+static uint32 list_loop_count;
+
+void karte_t::world_list_loop(list_loop_func function, uint32 count)
+{
+	list_loop_function = function;
+	list_loop_count = count;
+	// each thread gets a band of rows, which is mapped to its part of the list
+	world_xy_loop(&karte_t::list_loop_part, 0);
+}
+
+
+void karte_t::list_loop_part(sint16, sint16, sint16 y_min, sint16 y_max)
+{
+	const uint64 max_y = cached_grid_size.y;
+	const uint32 first = (uint32)((list_loop_count * (uint64)y_min) / max_y);
+	const uint32 last  = (uint32)((list_loop_count * (uint64)y_max) / max_y);
+	if(  first < last  ) {
+		(this->*list_loop_function)( first, last );
+	}
+}
+
+
 void karte_t::recalc_season_snowline(bool set_pending)
 {
 	static const sint8 mfactor[12] = { 99, 95, 80, 50, 25, 10, 0, 5, 20, 35, 65, 85 };
@@ -298,6 +324,8 @@ void karte_t::recalc_season_snowline(bool set_pending)
 	snowline = summerline - (sint8)(((summerline-winterline)*factor)/100);
 	if(  old_snowline != snowline  &&  set_pending  ) {
 		pending_snowline_change++;
+		snowline_change_min = min( snowline_change_min, (sint8)min( old_snowline, (sint16)snowline ) );
+		snowline_change_max = max( snowline_change_max, (sint8)max( old_snowline, (sint16)snowline ) );
 	}
 }
 
@@ -449,6 +477,7 @@ void karte_t::destroy()
 	// removes all moving stuff from the sync_step
 	sync.clear();
 	sync_buildings.clear();
+	gebaeude_t::clear_animations();
 	sync_roadsigns.clear();
 	old_progress += cached_size.x*cached_size.y;
 	ls.set_progress( old_progress );
@@ -618,7 +647,8 @@ void karte_t::init_tiles()
 
 	uint32 const x = get_size().x;
 	uint32 const y = get_size().y;
-	plan      = new planquadrat_t[x * y];
+	plan      = new planquadrat_t[get_plan_alloc_size(get_size())];
+	plan_blocks_x = get_plan_blocks(get_size().x);
 	grid_hgts = new sint8[(x + 1) * (y + 1)];
 	max_height = min_height = 0;
 	MEMZERON(grid_hgts, (x + 1) * (y + 1));
@@ -652,6 +682,8 @@ void karte_t::init_tiles()
 	last_frame_idx = 0;
 	pending_season_change = 0;
 	pending_snowline_change = 0;
+	snowline_change_min = 127;
+	snowline_change_max = -128;
 
 	// init global history
 	for (int year=0; year<MAX_WORLD_HISTORY_YEARS; year++) {
@@ -1495,8 +1527,10 @@ void karte_t::create_lakes(  int xoff, int yoff, sint8 max_lake_height  )
 	delete [] new_stage;
 	delete [] local_stage;
 
-	for (planquadrat_t *pl = plan; pl < (plan + size_x * size_y); pl++) {
-		pl->correct_water();
+	for(  uint16 iy = 0;  iy < size_y;  iy++  ) {
+		for(  uint16 ix = 0;  ix < size_x;  ix++  ) {
+			access_nocheck(ix, iy)->correct_water();
+		}
 	}
 }
 
@@ -1673,7 +1707,8 @@ void karte_t::enlarge_map(settings_t const* sets, sint8 const* const h_field)
 		grund_t::enlarge_map( new_size.x, new_size.y );
 	}
 
-	planquadrat_t *new_plan = new planquadrat_t[(uint32) new_size.x      * (uint32) new_size.y];
+	planquadrat_t *new_plan = new planquadrat_t[get_plan_alloc_size(new_size)];
+	const uint32 new_plan_blocks_x = get_plan_blocks(new_size.x);
 	sint8 *new_grid_hgts    = new sint8        [(uint32)(new_size.x + 1) * (uint32)(new_size.y + 1)];
 	sint8 *new_water_hgts   = new sint8        [(uint32) new_size.x      * (uint32) new_size.y];
 
@@ -1709,7 +1744,7 @@ void karte_t::enlarge_map(settings_t const* sets, sint8 const* const h_field)
 			for (sint16 ix = 0; ix<old_size.x; ix++) {
 				uint32 nr = ix+(iy*old_size.x);
 				uint32 nnr = ix+(iy*new_size.x);
-				swap(new_plan[nnr], plan[nr]);
+				swap(new_plan[get_plan_index(ix, iy, new_plan_blocks_x)], plan[get_plan_index(ix, iy)]);
 				new_water_hgts[nnr] = water_hgts[nr];
 			}
 		}
@@ -1729,6 +1764,7 @@ void karte_t::enlarge_map(settings_t const* sets, sint8 const* const h_field)
 
 	delete [] plan;
 	plan = new_plan;
+	plan_blocks_x = new_plan_blocks_x;
 	delete [] grid_hgts;
 	grid_hgts = new_grid_hgts;
 	delete [] water_hgts;
@@ -2287,6 +2323,7 @@ void karte_t::local_set_tool( tool_t *tool_in, player_t * player )
 
 
 planquadrat_t *rotate90_new_plan;
+uint32 rotate90_new_plan_blocks_x;
 sint8 *rotate90_new_water;
 
 void karte_t::rotate90_plans(sint16 x_min, sint16 x_max, sint16 y_min, sint16 y_max)
@@ -2297,8 +2334,8 @@ void karte_t::rotate90_plans(sint16 x_min, sint16 x_max, sint16 y_min, sint16 y_
 			for(  int xx = x_min;  xx < x_max;  xx += LOOP_BLOCK  ) {
 				for(  int y = yy;  y < min(yy + LOOP_BLOCK, y_max);  y++  ) {
 					for(  int x = xx;  x < min(xx + LOOP_BLOCK, x_max);  x++  ) {
-						const int nr = x + (y * cached_grid_size.x);
-						const int new_nr = (cached_size.y - y) + (x * cached_grid_size.y);
+						const uint32 nr = get_plan_index(x, y);
+						const uint32 new_nr = get_plan_index(cached_size.y - y, x, rotate90_new_plan_blocks_x);
 						// first rotate everything on the ground(s)
 						for(  uint i = 0;  i < plan[nr].get_boden_count();  i++  ) {
 							plan[nr].get_boden_bei(i)->rotate90();
@@ -2320,8 +2357,8 @@ void karte_t::rotate90_plans(sint16 x_min, sint16 x_max, sint16 y_min, sint16 y_
 					for(  int y=yy;  y < min(yy + LOOP_BLOCK, y_max);  y++  ) {
 						// rotate climate transitions
 						rotate_transitions( koord( x, y ) );
-						const int nr = x + (y * cached_grid_size.x);
-						const int new_nr = (cached_size.y - y) + (x * cached_grid_size.y);
+						const uint32 nr = get_plan_index(x, y);
+						const uint32 new_nr = get_plan_index(cached_size.y - y, x, rotate90_new_plan_blocks_x);
 						swap(rotate90_new_plan[new_nr], plan[nr]);
 					}
 				}
@@ -2332,7 +2369,7 @@ void karte_t::rotate90_plans(sint16 x_min, sint16 x_max, sint16 y_min, sint16 y_
 			for(  int yy = y_min;  yy < y_max;  yy += LOOP_BLOCK  ) {
 				for(  int x = xx;  x < min(xx + LOOP_BLOCK, x_max);  x++  ) {
 					for(  int y = yy;  y < min(yy + LOOP_BLOCK, y_max);  y++  ) {
-						const int new_nr = (cached_size.y - y) + (x * cached_grid_size.y);
+						const uint32 new_nr = get_plan_index(cached_size.y - y, x, rotate90_new_plan_blocks_x);
 						for(  uint i = 0;  i < rotate90_new_plan[new_nr].get_boden_count();  i++  ) {
 							rotate90_new_plan[new_nr].get_boden_bei(i)->rotate90();
 						}
@@ -2379,7 +2416,8 @@ DBG_MESSAGE( "karte_t::rotate90()", "called" );
 	assert(cached_grid_size.x >= 0);
 	assert(cached_grid_size.y >= 0);
 
-	rotate90_new_plan  = new planquadrat_t[(uint32_t)cached_grid_size.y * (uint32_t)cached_grid_size.x];
+	rotate90_new_plan  = new planquadrat_t[get_plan_alloc_size(koord(cached_grid_size.y, cached_grid_size.x))];
+	rotate90_new_plan_blocks_x = get_plan_blocks(cached_grid_size.y);
 	rotate90_new_water = new sint8        [(uint32_t)cached_grid_size.y * (uint32_t)cached_grid_size.x];
 
 	//rotate plans in parallel posix thread ...
@@ -2389,6 +2427,7 @@ DBG_MESSAGE( "karte_t::rotate90()", "called" );
 
 	delete [] plan;
 	plan = rotate90_new_plan;
+	plan_blocks_x = rotate90_new_plan_blocks_x;
 	delete[] water_hgts;
 	water_hgts = rotate90_new_water;
 
@@ -2644,6 +2683,7 @@ stadt_t *karte_t::find_nearest_city(const koord k) const
  */
 void karte_t::sync_step(uint32 delta_t)
 {
+	profile_scope_t const profile_sync_step(PROFILE_SYNC_STEP);
 	set_random_mode( SYNC_STEP_RANDOM );
 
 	// only omitted, when called to display a new frame during fast forward
@@ -2673,7 +2713,10 @@ void karte_t::sync_step(uint32 delta_t)
 
 	senke_t::sync_handler(delta_t);
 
-	sync.sync_step( delta_t );
+	{
+		profile_scope_t const profile_sync_lists(PROFILE_SYNC_LISTS);
+		sync.sync_step( delta_t );
+	}
 
 	ticker::update();
 
@@ -2734,7 +2777,10 @@ void karte_t::display(uint32 delta_t)
 	}
 
 	// display new frame with water animation
-	intr_refresh_display( false );
+	{
+		profile_scope_t const profile_display(PROFILE_DISPLAY);
+		intr_refresh_display( false );
+	}
 	update_frame_sleep_time();
 
 	clear_random_mode( SYNC_STEP_RANDOM );
@@ -3151,6 +3197,7 @@ void karte_t::set_schedule_counter()
 
 void karte_t::step()
 {
+	profile_scope_t const profile_step(PROFILE_STEP);
 	DBG_DEBUG4("karte_t::step", "start step");
 	uint32 step_start_time = dr_time();
 
@@ -3169,6 +3216,7 @@ void karte_t::step()
 		next_month_ticks += karte_t::ticks_per_world_month;
 
 		DBG_DEBUG4("karte_t::step", "calling new_month");
+		profile_scope_t const profile_month(PROFILE_NEW_MONTH);
 		new_month();
 	}
 
@@ -3230,10 +3278,12 @@ void karte_t::step()
 	// check for pending seasons change
 	const bool season_change = pending_season_change > 0;
 	const bool snowline_change = pending_snowline_change > 0;
-	if(  season_change  ||  snowline_change  ) {
+	if(  season_change  ) {
 		DBG_DEBUG4("karte_t::step", "pending_season_change");
-		// process
-		const uint32 end_count = min( cached_grid_size.x * cached_grid_size.y,  tile_counter + max( 16384, cached_grid_size.x * cached_grid_size.y / 16 ) );
+		// trees age and spawn here, so this must run serial and in the same order on all clients
+		// process in storage order, padding tiles have no grounds and are skipped
+		const uint32 plan_count = get_plan_count();
+		const uint32 end_count = min( plan_count,  tile_counter + max( 16384u, plan_count / 16 ) );
 		while(  tile_counter < end_count  ) {
 			plan[tile_counter].check_season_snowline( season_change, snowline_change );
 			tile_counter++;
@@ -3242,63 +3292,92 @@ void karte_t::step()
 			}
 		}
 
-		if(  tile_counter >= (uint32)cached_grid_size.x * (uint32)cached_grid_size.y  ) {
-			if(  season_change ) {
-				pending_season_change--;
-			}
+		if(  tile_counter >= plan_count  ) {
+			pending_season_change--;
 			if(  snowline_change  ) {
 				pending_snowline_change--;
 			}
+			if(  pending_snowline_change == 0  ) {
+				snowline_change_min = 127;
+				snowline_change_max = -128;
+			}
 			tile_counter = 0;
 		}
 	}
+	else if(  snowline_change  ) {
+		DBG_DEBUG4("karte_t::step", "pending_snowline_change");
+		// only images change, so only tiles near the snowline need an update and this can be done in parallel at once
+		world_xy_loop(&karte_t::update_snowline_loop, SYNCX_FLAG);
+		pending_snowline_change = 0;
+		snowline_change_min = 127;
+		snowline_change_max = -128;
+		set_dirty();
+	}
 
 	// to make sure the tick counter will be updated
 	INT_CHECK("karte_t::step");
 
 	DBG_DEBUG4("karte_t::step", "step convois");
-	// since convois will be deleted during stepping, we need to step backwards
-	for (sint32 i = (sint32)convoi_array.get_count(); i-- > 0; ) {
-		convoihandle_t cnv = convoi_array[i];
-		cnv->step();
-		if((i&15)==0) {
-			INT_CHECK("simworld 1947");
+	{
+		profile_scope_t const profile_convois(PROFILE_CONVOIS);
+		// since convois will be deleted during stepping, we need to step backwards
+		for (sint32 i = (sint32)convoi_array.get_count(); i-- > 0; ) {
+			convoihandle_t cnv = convoi_array[i];
+			cnv->step();
+			if((i&15)==0) {
+				INT_CHECK("simworld 1947");
+			}
 		}
 	}
 
 	// now step all towns (to generate passengers)
 	DBG_DEBUG4("karte_t::step", "step cities");
 	sint64 bev=0;
-	for(stadt_t* const i : cities) {
-		i->step(delta_t);
-		bev += i->get_finance_history_month(0, HIST_CITIZENS);
+	{
+		profile_scope_t const profile_cities(PROFILE_CITIES);
+		for(stadt_t* const i : cities) {
+			i->step(delta_t);
+			bev += i->get_finance_history_month(0, HIST_CITIZENS);
+		}
 	}
 
 	// the inhabitants stuff
 	finance_history_month[0][WORLD_CITIZENS] = bev;
 
 	DBG_DEBUG4("karte_t::step", "step factories");
-	for(fabrik_t* const f : fab_list) {
-		f->step(delta_t);
+	{
+		profile_scope_t const profile_factories(PROFILE_FACTORIES);
+		for(fabrik_t* const f : fab_list) {
+			f->step(delta_t);
+		}
 	}
 	finance_history_year[0][WORLD_FACTORIES] = finance_history_month[0][WORLD_FACTORIES] = fab_list.get_count();
 
 	// step powerlines - required order: powernet, pumpe then senke
 	DBG_DEBUG4("karte_t::step", "step poweline stuff");
-	powernet_t::step_all(delta_t);
-	pumpe_t::sync_handler(delta_t);
+	{
+		profile_scope_t const profile_powernet(PROFILE_POWERNET);
+		powernet_t::step_all(delta_t);
+		pumpe_t::sync_handler(delta_t);
+	}
 //	senke_t::step_all(delta_t); // not needed, handeld by sunc_step already
 
 	DBG_DEBUG4("karte_t::step", "step players");
-	// then step all players
-	for(  int i=0;  i<MAX_PLAYER_COUNT;  i++  ) {
-		if(  players[i] != NULL  ) {
-			players[i]->step();
+	{
+		profile_scope_t const profile_players(PROFILE_PLAYERS);
+		// then step all players
+		for(  int i=0;  i<MAX_PLAYER_COUNT;  i++  ) {
+			if(  players[i] != NULL  ) {
+				players[i]->step();
+			}
 		}
 	}
 
 	DBG_DEBUG4("karte_t::step", "step halts");
-	haltestelle_t::step_all();
+	{
+		profile_scope_t const profile_halts(PROFILE_HALTS);
+		haltestelle_t::step_all();
+	}
 
 	// ok, next step
 	INT_CHECK("simworld 1975");
@@ -4037,6 +4116,25 @@ void karte_t::plans_finish_rd( sint16 x_min, sint16 x_max, sint16 y_min, sint16
 }
 
 
+void karte_t::halts_finish_rd_cargo(uint32 first, uint32 last)
+{
+	const vector_tpl<halthandle_t> &halts = haltestelle_t::get_alle_haltestellen();
+	for(  uint32 i = first;  i < last;  i++  ) {
+		if(  halts[i]->get_owner()  &&  halts[i]->existiert_in_welt()  ) {
+			halts[i]->finish_rd_cargo();
+		}
+	}
+}
+
+
+void karte_t::cities_recalc_target_cities(uint32 first, uint32 last)
+{
+	for(  uint32 i = first;  i < last;  i++  ) {
+		cities[i]->recalc_target_cities();
+	}
+}
+
+
 void karte_t::load(loadsave_t *file)
 {
 	intr_disable();
@@ -4061,7 +4159,10 @@ void karte_t::load(loadsave_t *file)
 	// jetzt geht das Laden los
 	dbg->message("karte_t::load", "File version: %u", file->get_version_int());
 
+	// millions of tiles and objects are created now, so allocate them in large chunks
+	freelist_t::set_bulk_mode( true );
 	rdwr_gamestate(file, &ls);
+	freelist_t::set_bulk_mode( false );
 
 	// now the player can be loaded
 	for(int i=0; i<MAX_PLAYER_COUNT; i++) {
@@ -4118,11 +4219,12 @@ DBG_MESSAGE("karte_t::load()", "laden_abschliesen for tiles finished" );
 	weighted_vector_tpl<stadt_t*> new_cities(cities.get_count() + 1);
 	for(stadt_t* const s : cities) {
 		s->finish_rd();
-		s->recalc_target_cities();
 		new_cities.append(s, s->get_einwohner());
 		INT_CHECK("simworld 1278");
 	}
 	swap(cities, new_cities);
+	// the targets depend on the size of all cities, so only after all cities are finished
+	world_list_loop(&karte_t::cities_recalc_target_cities, cities.get_count());
 	DBG_MESSAGE("karte_t::load()", "cities initialized");
 
 	ls.set_progress( (get_size().y*3)/2+256+get_size().y/4 );
@@ -4149,9 +4251,18 @@ DBG_MESSAGE("karte_t::load()", "%d factories loaded", fab_list.get_count());
 	}
 	ls.set_progress( (get_size().y*3)/2+256+get_size().y/3 );
 
+	// old games may create stops while resolving goods, so only newer ones can do this in parallel
+	const bool parallel_cargo = load_version > 111005;
+	if(  parallel_cargo  ) {
+		world_list_loop(&karte_t::halts_finish_rd_cargo, haltestelle_t::get_alle_haltestellen().get_count());
+	}
+
 	// resolve dummy stops into real stops first ...
 	for(halthandle_t const i : haltestelle_t::get_alle_haltestellen()) {
 		if (i->get_owner() && i->existiert_in_welt()) {
+			if(  !parallel_cargo  ) {
+				i->finish_rd_cargo();
+			}
 			i->finish_rd();
 		}
 	}
@@ -4551,7 +4662,7 @@ void karte_t::rdwr_gamestate(loadsave_t *file, loadingscreen_t *ls)
 
 		for (int y = 0; y < get_size().y; y++) {
 			for (int x = 0; x < get_size().x; x++) {
-				plan[x+y*cached_grid_size.x].rdwr(file, koord(x,y) );
+				access_nocheck(x, y)->rdwr(file, koord(x,y) );
 			}
 			if(file->is_eof()) {
 				dbg->fatal("karte_t::rdwr_gamestate()","Savegame file mangled (too short)!");
@@ -4562,7 +4673,7 @@ void karte_t::rdwr_gamestate(loadsave_t *file, loadingscreen_t *ls)
 	else {
 		for(int j=0; j<get_size().y; j++) {
 			for(int i=0; i<get_size().x; i++) {
-				plan[i+j*cached_grid_size.x].rdwr(file, koord(i,j) );
+				access_nocheck(i, j)->rdwr(file, koord(i,j) );
 			}
 			if(!ls) {
 				INT_CHECK("saving");
@@ -4820,6 +4931,43 @@ void karte_t::rdwr_gamestate(loadsave_t *file, loadingscreen_t *ls)
 }
 
 
+void karte_t::update_snowline_loop(sint16 x_min, sint16 x_max, sint16 y_min, sint16 y_max)
+{
+	// a tile is only affected, if some of its images are between the old and the new snowline
+	// (ways and buildings can be drawn a few levels above their ground, hence the margin)
+	const bool all_tiles = snowline_change_min > snowline_change_max;
+	const sint16 lower = snowline_change_min - 1;
+	const sint16 upper = snowline_change_max;
+	const sint16 margin = 4;
+
+	for(  sint16 y = y_min;  y < y_max;  y++  ) {
+		for(  sint16 x = x_min;  x < x_max;  x++  ) {
+			const planquadrat_t *pl = access_nocheck(x, y);
+			if(  !all_tiles  &&  pl->get_boden_count() == 1  ) {
+				if(  pl->get_climate() == arctic_climate  ) {
+					// always snowy
+					continue;
+				}
+				// only grid heights, so we do not need to touch the ground
+				sint16 hmin = get_water_hgt_nocheck(x, y);
+				sint16 hmax = hmin;
+				for(  sint16 j = 0;  j < 2;  j++  ) {
+					for(  sint16 i = 0;  i < 2;  i++  ) {
+						const sint16 h = lookup_hgt_nocheck(x + i, y + j);
+						hmin = min(hmin, h);
+						hmax = max(hmax, h);
+					}
+				}
+				if(  hmax + margin < lower  ||  hmin > upper  ) {
+					continue;
+				}
+			}
+			pl->check_snowline();
+		}
+	}
+}
+
+
 // recalcs all ground tiles on the map
 void karte_t::update_map_intern(sint16 x_min, sint16 x_max, sint16 y_min, sint16 y_max)
 {
@@ -4829,7 +4977,7 @@ void karte_t::update_map_intern(sint16 x_min, sint16 x_max, sint16 y_min, sint16
 			for(  int yy = y_min;  yy < y_max;  yy += LOOP_BLOCK  ) {
 				for(  int y = yy;  y < min(yy + LOOP_BLOCK, y_max);  y++  ) {
 					for(  int x = xx;  x < min(xx + LOOP_BLOCK, x_max);  x++  ) {
-						const int nr = y * cached_grid_size.x + x;
+						const uint32 nr = get_plan_index(x, y);
 						for(  uint i = 0;  i < plan[nr].get_boden_count();  i++  ) {
 							plan[nr].get_boden_bei(i)->calc_image();
 						}
@@ -4841,7 +4989,7 @@ void karte_t::update_map_intern(sint16 x_min, sint16 x_max, sint16 y_min, sint16
 	else {
 		for(  int y = y_min;  y < y_max;  y++  ) {
 			for(  int x = x_min;  x < x_max;  x++  ) {
-				const int nr = y * cached_grid_size.x + x;
+				const uint32 nr = get_plan_index(x, y);
 				for(  uint i = 0;  i < plan[nr].get_boden_count();  i++  ) {
 					plan[nr].get_boden_bei(i)->calc_image();
 				}
@@ -4994,7 +5142,7 @@ void karte_t::prepare_tiles(rect_t const &new_area, rect_t const &old_area) {
 
 		for (sint16 y = y_start ; y < y_end ; y++) {
 			for (sint16 x = x_start ; x < x_end ; x++) {
-				const planquadrat_t &tile = plan[y * cached_grid_size.x + x];
+				const planquadrat_t &tile = *access_nocheck(x, y);
 				tile.update_underground();
 			}
 		}
@@ -6416,6 +6564,26 @@ bool karte_t::interactive(uint32 quit_month)
 }
 
 
+uint32 karte_t::run_headless(uint32 months)
+{
+	const uint32 quit_month = get_current_month() + months;
+	const sint32 start_steps = steps;
+
+	set_fast_forward( true );
+	intr_disable();
+	while(  get_current_month() < quit_month  &&  !env_t::quit_simutrans  ) {
+		// the same as fast forward in interactive(), just without any display
+		sync_step( 100 );
+		set_random_mode( STEP_RANDOM );
+		step();
+		clear_random_mode( STEP_RANDOM );
+	}
+	set_fast_forward( false );
+
+	return steps - start_steps;
+}
+
+
 // Announce server to central listing server
 // Status is one of:
 // 0 - startup
@@ -60,6 +60,11 @@ class building_desc_t;
  */
 typedef void (karte_t::*xy_loop_func)(sint16, sint16, sint16, sint16);
 
+/**
+ * Threaded function caller for a part [first, last) of a list.
+ */
+typedef void (karte_t::*list_loop_func)(uint32, uint32);
+
 
 /**
  * The map is the central part of the simulation. It stores all data and objects.
@@ -69,6 +74,7 @@ class karte_t : public surface_t
 {
 	friend karte_t* world();  // to access the single instance
 	friend class karte_ptr_t; // to access the single instance
+	friend class benchmark_t; // to call new_month()
 
 	static karte_t* world; ///< static single instance
 
@@ -205,6 +211,12 @@ private:
 	sint8 pending_season_change;
 	sint8 pending_snowline_change;
 
+	/**
+	 * Range of snowline heights since the last snowline update of the map.
+	 * Only tiles within this range must be updated; min>max means unknown, i.e. update all.
+	 */
+	sint8 snowline_change_min, snowline_change_max;
+
 	/**
 	 * Recalculates sleep time etc.
 	 */
@@ -537,6 +549,23 @@ private:
 	void world_xy_loop(xy_loop_func func, uint8 flags);
 	static void *world_xy_loop_thread(void *);
 
+	/**
+	 * Splits the indices 0..count-1 among the world threads.
+	 * The parts must not depend on each other.
+	 */
+	void world_list_loop(list_loop_func func, uint32 count);
+	void list_loop_part(sint16, sint16, sint16, sint16);
+
+	/**
+	 * Sorts the goods of all halts after load.
+	 */
+	void halts_finish_rd_cargo(uint32 first, uint32 last);
+
+	/**
+	 * Recalculates the passenger targets of the cities after load.
+	 */
+	void cities_recalc_target_cities(uint32 first, uint32 last);
+
 	/**
 	 * Loops over plans after load.
 	 */
@@ -547,6 +576,11 @@ private:
 	 */
 	void update_map_intern(sint16, sint16, sint16, sint16);
 
+	/**
+	 * Updates snowline dependent images of all tiles within the snowline change range.
+	 */
+	void update_snowline_loop(sint16, sint16, sint16, sint16);
+
 	bool can_flood_to_depth(koord k, sint8 new_water_height, sint8 *stage, sint8 *our_stage, sint16, sint16, sint16, sint16) const;
 
 	void flood_to_depth(sint8 new_water_height, sint8 *stage);
@@ -1108,7 +1142,7 @@ public:
 	};
 
 	sync_list_t<convoi_t>   sync;           ///< vehicles
-	sync_list_t<gebaeude_t> sync_buildings; ///< animated buildings
+	sync_list_t<gebaeude_t> sync_buildings; ///< construction sites
 	sync_list_t<roadsign_t> sync_roadsigns; ///< traffic lights
 
 	/**
@@ -1210,6 +1244,14 @@ public:
 	 */
 	bool interactive(uint32 quit_month);
 
+	/**
+	 * Runs the simulation for @p months without display, sleeping or waiting for events.
+	 * The order of sync_step() and step() depends only on the game, so the same game
+	 * will always end with the same get_gamestate_hash().
+	 * @return number of steps done
+	 */
+	uint32 run_headless(uint32 months);
+
 	uint32 get_sync_steps() const { return sync_steps; }
 
 	/**
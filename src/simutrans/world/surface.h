@@ -74,10 +74,17 @@ protected:
 
 	/**
 	 * Array containing all the map tiles.
+	 * The tiles are not stored row by row but in square blocks of
+	 * (1<<PLAN_BLOCK_BITS)^2 tiles, so tiles next to each other (also in y direction)
+	 * share cache lines. Always index via get_plan_index()!
 	 * @see cached_size
+	 * @see get_plan_index
 	 */
 	planquadrat_t *plan = NULL;
 
+	/// Number of tile blocks in x direction of the plan array.
+	uint32 plan_blocks_x = 0;
+
 	/**
 	 * Array representing the height of each point of the grid.
 	 * @see cached_grid_size
@@ -238,6 +245,28 @@ public:
 		return access(koord(pos.x, pos.y-1))->get_kartenboden();
 	}
 
+public:
+	/// @returns number of blocks needed to store @p tiles tiles in one direction
+	static inline uint32 get_plan_blocks(sint16 tiles) { return ((uint32)tiles + PLAN_BLOCK_MASK) >> PLAN_BLOCK_BITS; }
+
+	/// @returns number of planquadrat_t to allocate for a map of size @p size (including padding of the last blocks)
+	static inline uint32 get_plan_alloc_size(koord size) { return (get_plan_blocks(size.x) * get_plan_blocks(size.y)) << (2*PLAN_BLOCK_BITS); }
+
+	/**
+	 * @return index of tile x,y in a plan array with @p blocks_x blocks per row
+	 * @note Inline because called very frequently!
+	 */
+	static inline uint32 get_plan_index(sint16 x, sint16 y, uint32 blocks_x)
+	{
+		return ((((uint32)y >> PLAN_BLOCK_BITS) * blocks_x + ((uint32)x >> PLAN_BLOCK_BITS)) << (2*PLAN_BLOCK_BITS))
+			+ (((uint32)y & PLAN_BLOCK_MASK) << PLAN_BLOCK_BITS) + ((uint32)x & PLAN_BLOCK_MASK);
+	}
+
+	inline uint32 get_plan_index(sint16 x, sint16 y) const { return get_plan_index(x, y, plan_blocks_x); }
+
+	/// @returns number of entries in the plan array, padding tiles (without any ground) included
+	inline uint32 get_plan_count() const { return plan ? get_plan_alloc_size(cached_grid_size) : 0; }
+
 public:
 	/**
 	 * @return grund at the bottom (where house will be build)
@@ -245,7 +274,7 @@ public:
 	 */
 	inline grund_t *lookup_kartenboden_nocheck(const sint16 x, const sint16 y) const
 	{
-		return plan[x+y*cached_grid_size.x].get_kartenboden();
+		return plan[get_plan_index(x, y)].get_kartenboden();
 	}
 
 	inline grund_t *lookup_kartenboden_nocheck(const koord &pos) const { return lookup_kartenboden_nocheck(pos.x, pos.y); }
@@ -256,20 +285,20 @@ public:
 	 */
 	inline grund_t *lookup_kartenboden(const sint16 x, const sint16 y) const
 	{
-		return is_within_limits(x, y) ? plan[x+y*cached_grid_size.x].get_kartenboden() : NULL;
+		return is_within_limits(x, y) ? plan[get_plan_index(x, y)].get_kartenboden() : NULL;
 	}
 
 	inline grund_t *lookup_kartenboden(const koord &pos) const { return lookup_kartenboden(pos.x, pos.y); }
 
 public:
 	inline planquadrat_t *access_nocheck(sint16 x, sint16 y) const {
-		return &plan[x + y*cached_grid_size.x];
+		return &plan[get_plan_index(x, y)];
 	}
 
 	inline planquadrat_t *access_nocheck(koord k) const { return access_nocheck(k.x, k.y); }
 
 	inline planquadrat_t *access(sint16 x, sint16 y) const {
-		return is_within_limits(x, y) ? &plan[x + y*cached_grid_size.x] : NULL;
+		return is_within_limits(x, y) ? &plan[get_plan_index(x, y)] : NULL;
 	}
 
 	inline planquadrat_t *access(koord k) const { return access(k.x, k.y); }
@@ -26,10 +26,12 @@ include("tests/test_scenario")
 include("tests/test_sign")
 include("tests/test_slope")
 include("tests/test_terraform")
+include("tests/test_tiles")
 include("tests/test_transport")
 include("tests/test_trees")
 include("tests/test_way_bridge")
 include("tests/test_way_road")
+include("tests/test_pathfinding")
 include("tests/test_way_runway")
 include("tests/test_way_tram")
 include("tests/test_way_tunnel")
@@ -178,6 +180,8 @@ all_tests <- [
 	test_terraform_raise_lower_land_at_water_edge,
 	test_terraform_raise_lower_land_below_way,
 	test_terraform_raise_lower_water_level,
+	test_tiles_bulk_query,
+	test_tiles_bulk_benchmark,
 	test_transport_generate_pax_invalid_pos,
 	test_transport_generate_pax_walked,
 	test_transport_generate_pax_no_route,
@@ -217,6 +221,9 @@ all_tests <- [
 	test_way_road_cityroad_replace_keep_existing,
 	test_way_road_has_double_slopes,
 	test_way_road_make_public,
+	test_pathfinding_way_planner_road,
+	test_pathfinding_way_planner_invalid_params,
+	test_pathfinding_route_planner_road,
 	test_way_runway_build_rw_flat,
 	test_way_runway_build_tw_flat,
 	test_way_runway_build_mixed_flat,
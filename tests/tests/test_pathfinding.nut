@@ -0,0 +1,145 @@
+//
+// This file is part of the Simutrans project under the Artistic License.
+// (see LICENSE.txt)
+//
+
+
+//
+// Tests for the native route searches (way_planner_x, route_planner_x)
+//
+
+
+function test_pathfinding_way_planner_road()
+{
+	local pl   = player_x(0)
+	local desc = way_desc_x.get_available_ways(wt_road, st_flat)[0]
+	ASSERT_TRUE(desc != null)
+
+	local planner = way_planner_x(pl)
+	planner.set_build_types(desc)
+
+	// route on empty ground: from target back to start
+	{
+		local route = planner.calc_route(coord3d(2, 1, 0), coord3d(2, 6, 0))
+		ASSERT_EQUAL(route.len(), 6)
+		ASSERT_EQUAL(route[0].tostring(), coord3d(2, 6, 0).tostring())
+		ASSERT_EQUAL(route[route.len()-1].tostring(), coord3d(2, 1, 0).tostring())
+	}
+
+	// route along an existing road
+	ASSERT_EQUAL(command_x.build_way(pl, coord3d(2, 1, 0), coord3d(2, 6, 0), desc, true), null)
+	{
+		local route = planner.calc_route([ coord3d(2, 1, 0) ], [ coord3d(2, 6, 0) ])
+		ASSERT_EQUAL(route.len(), 6)
+		ASSERT_EQUAL(route[0].tostring(), coord3d(2, 6, 0).tostring())
+		ASSERT_EQUAL(route[route.len()-1].tostring(), coord3d(2, 1, 0).tostring())
+	}
+
+	// no route to a tile outside the map
+	{
+		local route = planner.calc_route(coord3d(2, 1, 0), coord3d(-1, -1, 0))
+		ASSERT_EQUAL(route.len(), 0)
+	}
+
+	// searching must not build anything
+	ASSERT_WAY_PATTERN(wt_road, coord3d(0, 0, 0),
+		[
+			"........",
+			"..4.....",
+			"..5.....",
+			"..5.....",
+			"..5.....",
+			"..5.....",
+			"..1.....",
+			"........"
+		])
+
+	ASSERT_EQUAL(command_x(tool_remove_way).work(pl, coord3d(2, 1, 0), coord3d(2, 6, 0), "" + wt_road), null)
+	RESET_ALL_PLAYER_FUNDS()
+}
+
+
+function test_pathfinding_way_planner_invalid_params()
+{
+	local pl = player_x(0)
+
+	// no way type set
+	{
+		local planner = way_planner_x(pl)
+		local error_raised = false
+		try {
+			planner.calc_route(coord3d(2, 1, 0), coord3d(2, 6, 0))
+		}
+		catch (e) {
+			error_raised = true
+			ASSERT_EQUAL(e, "Call set_build_types() before calc_route()")
+		}
+		ASSERT_TRUE(error_raised)
+	}
+
+	// runways connect exactly two tiles
+	{
+		local runway_desc = way_desc_x.get_available_ways(wt_air, st_elevated)[0]
+		ASSERT_TRUE(runway_desc != null)
+
+		local planner = way_planner_x(pl)
+		planner.set_build_types(runway_desc)
+
+		local error_raised = false
+		try {
+			planner.calc_route([ coord3d(2, 1, 0), coord3d(3, 1, 0) ], coord3d(2, 6, 0))
+		}
+		catch (e) {
+			error_raised = true
+			ASSERT_EQUAL(e, "Runways need exactly one start and one target")
+		}
+		ASSERT_TRUE(error_raised)
+
+		error_raised = false
+		try {
+			planner.calc_route(coord3d(2, 1, 0), [ coord3d(2, 6, 0), coord3d(3, 6, 0) ])
+		}
+		catch (e) {
+			error_raised = true
+			ASSERT_EQUAL(e, "Runways need exactly one start and one target")
+		}
+		ASSERT_TRUE(error_raised)
+	}
+
+	RESET_ALL_PLAYER_FUNDS()
+}
+
+
+function test_pathfinding_route_planner_road()
+{
+	local pl        = player_x(0)
+	local road_desc = way_desc_x.get_available_ways(wt_road, st_flat)[0]
+	local vehicle   = vehicle_desc_x.get_available_vehicles(wt_road)[0]
+	ASSERT_TRUE(vehicle != null)
+
+	ASSERT_EQUAL(command_x.build_way(pl, coord3d(2, 1, 0), coord3d(2, 6, 0), road_desc, true), null)
+	ASSERT_EQUAL(command_x.build_way(pl, coord3d(5, 1, 0), coord3d(5, 3, 0), road_desc, true), null)
+
+	local old_cash = pl.get_current_cash()
+
+	// driven route: from start to target
+	{
+		local route = route_planner_x.calc_route(pl, vehicle, coord3d(2, 1, 0), coord3d(2, 6, 0))
+		ASSERT_EQUAL(route.len(), 6)
+		ASSERT_EQUAL(route[0].tostring(), coord3d(2, 1, 0).tostring())
+		ASSERT_EQUAL(route[route.len()-1].tostring(), coord3d(2, 6, 0).tostring())
+	}
+
+	// roads are not connected
+	{
+		local route = route_planner_x.calc_route(pl, vehicle, coord3d(2, 1, 0), coord3d(5, 3, 0))
+		ASSERT_EQUAL(route.len(), 0)
+	}
+
+	// the test vehicle must not be paid for
+	ASSERT_EQUAL(pl.get_current_cash(), old_cash)
+
+	ASSERT_EQUAL(command_x(tool_remove_way).work(pl, coord3d(2, 1, 0), coord3d(2, 6, 0), "" + wt_road), null)
+	ASSERT_EQUAL(command_x(tool_remove_way).work(pl, coord3d(5, 1, 0), coord3d(5, 3, 0), "" + wt_road), null)
+	RESET_ALL_PLAYER_FUNDS()
+}
@@ -0,0 +1,101 @@
+//
+// This file is part of the Simutrans project under the Artistic License.
+// (see LICENSE.txt)
+//
+
+
+//
+// Tests for querying rectangles of tiles
+//
+
+
+function test_tiles_bulk_query()
+{
+	local pl   = player_x(0)
+	local desc = way_desc_x.get_available_ways(wt_road, st_flat)[0]
+	ASSERT_TRUE(desc != null)
+	ASSERT_EQUAL(command_x.build_way(pl, coord3d(2, 1, 0), coord3d(2, 6, 0), desc, true), null)
+
+	local from = coord(1, 0)
+	local to   = coord(5, 7)
+	local w    = to.x - from.x + 1
+
+	local heights = square_x.get_heights(from, to)
+	local slopes  = square_x.get_slopes(to, from) // corners in any order
+	local dirs    = square_x.get_way_dirs(from, to, wt_road)
+	local owners  = square_x.get_owners(from, to)
+	local empty   = square_x.get_empty(from, to)
+	local halts   = square_x.get_halt_counts(from, to)
+
+	ASSERT_EQUAL(heights.len(), w * (to.y - from.y + 1))
+
+	for (local y = from.y; y <= to.y; y++) {
+		for (local x = from.x; x <= to.x; x++) {
+			local i    = (y - from.y) * w + (x - from.x)
+			local sq   = square_x(x, y)
+			local tile = sq.get_ground_tile()
+
+			ASSERT_EQUAL(heights[i], tile.z)
+			ASSERT_EQUAL(slopes[i], tile.get_slope())
+			ASSERT_EQUAL(dirs[i], tile.get_way_dirs(wt_road))
+			ASSERT_EQUAL(owners[i], tile.has_ways() ? 0 : -1)
+			ASSERT_EQUAL(empty[i], tile.is_empty() ? 1 : 0)
+			ASSERT_EQUAL(halts[i], sq.get_halt_list().len())
+		}
+	}
+
+	local error_raised = false
+	try {
+		square_x.get_heights(coord(0, 0), coord(16, 16))
+	}
+	catch (e) {
+		error_raised = true
+	}
+	ASSERT_TRUE(error_raised)
+
+	// clean up
+	local remover = command_x(tool_remove_way)
+	ASSERT_EQUAL(remover.work(pl, tile_x(2, 1, 0), tile_x(2, 6, 0), "" + wt_road), null)
+	RESET_ALL_PLAYER_FUNDS()
+}
+
+
+// Benchmark, compares querying every tile with querying the whole map at once
+function test_tiles_bulk_benchmark()
+{
+	local rounds = 20
+	local size   = world.get_size()
+	local from   = coord(0, 0)
+	local to     = coord(size.x - 1, size.y - 1)
+
+	local start = clock()
+	local sum_single = 0
+	for (local r = 0; r < rounds; r++) {
+		for (local y = 0; y < size.y; y++) {
+			for (local x = 0; x < size.x; x++) {
+				local sq   = square_x(x, y)
+				local tile = sq.get_ground_tile()
+				sum_single += tile.z + tile.get_slope() + tile.get_way_dirs(wt_road) + (tile.is_empty() ? 1 : 0) + sq.get_halt_list().len()
+			}
+		}
+	}
+	local time_single = clock() - start
+
+	start = clock()
+	local sum_bulk = 0
+	for (local r = 0; r < rounds; r++) {
+		local heights = square_x.get_heights(from, to)
+		local slopes  = square_x.get_slopes(from, to)
+		local dirs    = square_x.get_way_dirs(from, to, wt_road)
+		local empty   = square_x.get_empty(from, to)
+		local halts   = square_x.get_halt_counts(from, to)
+		for (local i = 0; i < heights.len(); i++) {
+			sum_bulk += heights[i] + slopes[i] + dirs[i] + empty[i] + halts[i]
+		}
+	}
+	local time_bulk = clock() - start
+
+	ASSERT_EQUAL(sum_bulk, sum_single)
+
+	print("  single tiles: " + time_single + " s, rectangles: " + time_bulk + " s, speedup " + (time_bulk > 0 ? time_single / time_bulk : "n/a"))
+}